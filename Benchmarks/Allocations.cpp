@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+
+#include <Luna/Utility/Delegate.hpp>
+#include <Luna/Utility/SmallVector.hpp>
+#include <cstdlib>
+#include <new>
+
+// Every global allocation in this executable is counted, so each benchmark can report how many heap allocations one
+// iteration performs. The counter is only read between iterations, so relaxed ordering is sufficient.
+static std::atomic_size_t AllocationCount = 0;
+
+void* operator new(size_t size) {
+	AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size == 0 ? 1 : size)) { return ptr; }
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+namespace Luna {
+// Stand-ins for the render graph resource types; only their pointers are stored.
+struct BenchTexture {};
+struct BenchBuffer {};
+
+static void ReportAllocations(benchmark::State& state, size_t startCount) {
+	const auto allocations  = AllocationCount.load(std::memory_order_relaxed) - startCount;
+	state.counters["Allocs"] = benchmark::Counter(double(allocations), benchmark::Counter::kAvgIterations);
+}
+
+// Collecting callback results, as Delegate::Invoke does for delegates which return a value.
+template <typename Container>
+static void BM_CollectResults(benchmark::State& state) {
+	const auto count      = size_t(state.range(0));
+	const auto startCount = AllocationCount.load(std::memory_order_relaxed);
+	for (auto _ : state) {
+		Container results;
+		results.reserve(count);
+		for (size_t i = 0; i < count; ++i) { results.push_back(int(i)); }
+		benchmark::DoNotOptimize(results.data());
+	}
+	ReportAllocations(state, startCount);
+}
+BENCHMARK(BM_CollectResults<std::vector<int>>)->Arg(1)->Arg(3)->Arg(16);
+BENCHMARK(BM_CollectResults<SmallVector<int, 4>>)->Arg(1)->Arg(3)->Arg(16);
+
+static void BM_DelegateInvoke(benchmark::State& state) {
+	Delegate<int(int)> delegate;
+	for (int64_t i = 0; i < state.range(0); ++i) {
+		delegate += [i](int value) { return value + int(i); };
+	}
+
+	const auto startCount = AllocationCount.load(std::memory_order_relaxed);
+	for (auto _ : state) {
+		auto results = delegate(1);
+		benchmark::DoNotOptimize(results.data());
+	}
+	ReportAllocations(state, startCount);
+}
+BENCHMARK(BM_DelegateInvoke)->Arg(1)->Arg(3)->Arg(16);
+
+// Recording a frame's worth of render passes, each of which declares a handful of color, storage and resolve resources
+// the way RenderPass does while the graph is being set up.
+template <template <typename> typename List>
+static void BM_RecordFrame(benchmark::State& state) {
+	struct Pass {
+		List<BenchTexture*> ColorInputs;
+		List<BenchTexture*> ColorOutputs;
+		List<BenchTexture*> ResolveOutputs;
+		List<BenchBuffer*> StorageInputs;
+		List<BenchBuffer*> StorageOutputs;
+	};
+
+	const auto passCount = size_t(state.range(0));
+
+	BenchTexture texture;
+	BenchBuffer buffer;
+	std::vector<Pass> passes(passCount);
+
+	const auto startCount = AllocationCount.load(std::memory_order_relaxed);
+	for (auto _ : state) {
+		for (auto& pass : passes) {
+			pass = {};
+			for (int i = 0; i < 4; ++i) {
+				pass.ColorInputs.push_back(nullptr);
+				pass.ColorOutputs.push_back(&texture);
+			}
+			pass.ResolveOutputs.push_back(&texture);
+			for (int i = 0; i < 2; ++i) {
+				pass.StorageInputs.push_back(&buffer);
+				pass.StorageOutputs.push_back(&buffer);
+			}
+		}
+		benchmark::DoNotOptimize(passes.data());
+	}
+	ReportAllocations(state, startCount);
+}
+template <typename T>
+using StdVectorList = std::vector<T>;
+template <typename T>
+using SmallVectorList = SmallVector<T, 8>;
+BENCHMARK(BM_RecordFrame<StdVectorList>)->Arg(8)->Arg(32);
+BENCHMARK(BM_RecordFrame<SmallVectorList>)->Arg(8)->Arg(32);
+}  // namespace Luna
+
+BENCHMARK_MAIN();
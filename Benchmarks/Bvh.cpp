@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+
+#include <Luna/Core/Threading.hpp>
+#include <Luna/Renderer/Bvh.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+// Bistro has roughly 3 million full-detail triangles, about 50,000 meshlets, spread over a few hundred meters of road.
+// These benchmarks use meshlet-sized boxes laid out the same way: clustered into objects, which are scattered over a
+// flat area. Deterministic, so results are comparable between runs and machines.
+namespace Luna {
+constexpr static float SceneSize            = 400.0f;
+constexpr static float SceneHeight          = 30.0f;
+constexpr static uint32_t MeshletsPerObject = 64;
+
+static std::vector<BvhBounds> MakeMeshletBounds(uint32_t count, uint64_t seed = 0x4c756e61) {
+	std::mt19937_64 rng(seed);
+	std::uniform_real_distribution<float> ground(-SceneSize * 0.5f, SceneSize * 0.5f);
+	std::uniform_real_distribution<float> height(0.0f, SceneHeight);
+	std::uniform_real_distribution<float> objectSize(0.5f, 8.0f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	std::vector<BvhBounds> bounds(count);
+	glm::vec3 objectCenter;
+	float objectExtent = 0.0f;
+	for (uint32_t i = 0; i < count; ++i) {
+		if (i % MeshletsPerObject == 0) {
+			objectCenter = glm::vec3(ground(rng), height(rng), ground(rng));
+			objectExtent = objectSize(rng);
+		}
+
+		const glm::vec3 center = objectCenter + (glm::vec3(unit(rng), unit(rng), unit(rng)) - 0.5f) * objectExtent;
+		const glm::vec3 extent = glm::vec3(unit(rng), unit(rng), unit(rng)) * objectExtent * 0.1f + 0.01f;
+		bounds[i]              = {center - extent, center + extent};
+	}
+
+	return bounds;
+}
+
+struct BenchRay {
+	glm::vec3 Origin;
+	glm::vec3 Direction;
+};
+
+// Rays from head height towards random points in the scene, as picking or line-of-sight queries would cast.
+static std::vector<BenchRay> MakeRays(uint32_t count, uint64_t seed = 0x52617973) {
+	std::mt19937_64 rng(seed);
+	std::uniform_real_distribution<float> ground(-SceneSize * 0.5f, SceneSize * 0.5f);
+	std::uniform_real_distribution<float> height(0.0f, SceneHeight);
+
+	std::vector<BenchRay> rays(count);
+	for (auto& ray : rays) {
+		ray.Origin    = glm::vec3(ground(rng), 2.0f, ground(rng));
+		ray.Direction = glm::normalize(glm::vec3(ground(rng), height(rng), ground(rng)) - ray.Origin);
+	}
+
+	return rays;
+}
+
+// Frustum planes in the form the renderer culls with, for a camera at head height looking along the ground.
+static std::array<glm::vec4, 6> MakeFrustum(uint32_t index) {
+	const float angle       = float(index) * 2.39996f;
+	const glm::vec3 eye     = glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * SceneSize * 0.25f + glm::vec3(0, 2, 0);
+	const glm::vec3 forward = glm::vec3(std::cos(angle * 3.0f), 0.0f, std::sin(angle * 3.0f));
+	const glm::mat4 view    = glm::lookAt(eye, eye + forward, glm::vec3(0, 1, 0));
+	const glm::mat4 vp      = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f) * view;
+
+	std::array<glm::vec4, 6> planes;
+	for (int i = 0; i < 4; ++i) {
+		planes[0][i] = vp[i][3] + vp[i][0];
+		planes[1][i] = vp[i][3] - vp[i][0];
+		planes[2][i] = vp[i][3] + vp[i][1];
+		planes[3][i] = vp[i][3] - vp[i][1];
+		planes[4][i] = vp[i][3] + vp[i][2];
+		planes[5][i] = vp[i][3] - vp[i][2];
+	}
+	for (auto& plane : planes) {
+		plane /= glm::length(glm::vec3(plane));
+		plane.w = -plane.w;
+	}
+
+	return planes;
+}
+
+static void BM_BvhBuild(benchmark::State& state) {
+	const bool parallel = state.range(0) != 0;
+	const auto bounds   = MakeMeshletBounds(uint32_t(state.range(1)));
+
+	Bvh bvh;
+	for (auto _ : state) {
+		bvh.Build(bounds, parallel);
+		benchmark::DoNotOptimize(bvh.GetNodeCount());
+	}
+
+	state.SetItemsProcessed(state.iterations() * int64_t(bounds.size()));
+	state.SetLabel(parallel ? "Parallel" : "Single thread");
+}
+BENCHMARK(BM_BvhBuild)->ArgsProduct({{0, 1}, {50'000, 1'000'000}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Closest hit against the boxes themselves, so the time is spent in traversal rather than in triangle tests.
+static void BM_BvhRaycast(benchmark::State& state) {
+	const auto bounds = MakeMeshletBounds(uint32_t(state.range(0)));
+	const auto rays   = MakeRays(4096);
+	Bvh bvh;
+	bvh.Build(bounds, true);
+
+	uint64_t hits = 0;
+	for (auto _ : state) {
+		for (const auto& ray : rays) {
+			const glm::vec3 inverseDirection = 1.0f / ray.Direction;
+			float maxDistance                = std::numeric_limits<float>::max();
+			bool hit                         = false;
+			bvh.Intersect(ray.Origin, ray.Direction, maxDistance, [&](uint32_t primitive, float& distance) {
+				const auto t0     = (bounds[primitive].Min - ray.Origin) * inverseDirection;
+				const auto t1     = (bounds[primitive].Max - ray.Origin) * inverseDirection;
+				const auto tNear  = glm::min(t0, t1);
+				const auto tFar   = glm::max(t0, t1);
+				const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+				const float exit  = std::min(std::min(tFar.x, tFar.y), tFar.z);
+				if (enter <= exit && enter < distance) {
+					distance = enter;
+					hit      = true;
+				}
+			});
+			hits += hit;
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * int64_t(rays.size()));
+	state.counters["HitRate"] = double(hits) / double(state.iterations() * rays.size());
+}
+BENCHMARK(BM_BvhRaycast)->Arg(50'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+
+static void BM_BvhFrustum(benchmark::State& state) {
+	const auto bounds = MakeMeshletBounds(uint32_t(state.range(0)));
+	Bvh bvh;
+	bvh.Build(bounds, true);
+
+	uint32_t frustum = 0;
+	uint64_t visible = 0;
+	for (auto _ : state) {
+		const auto planes = MakeFrustum(frustum++);
+		bvh.Intersect(std::span<const glm::vec4, 6>(planes), [&](uint32_t) { ++visible; });
+	}
+
+	state.SetItemsProcessed(state.iterations() * int64_t(bounds.size()));
+	state.counters["Visible"] = double(visible) / double(state.iterations());
+}
+BENCHMARK(BM_BvhFrustum)->Arg(50'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+
+// Moving a share of the primitives each iteration, as animated instances would, and refitting in place.
+static void BM_BvhRefit(benchmark::State& state) {
+	auto bounds             = MakeMeshletBounds(uint32_t(state.range(0)));
+	const auto movedPercent = uint32_t(state.range(1));
+	Bvh bvh;
+	bvh.Build(bounds, true);
+
+	std::mt19937_64 rng(0x52656669);
+	std::vector<uint32_t> changed;
+	for (uint32_t i = 0; i < bounds.size(); ++i) {
+		if (rng() % 100 < movedPercent) { changed.push_back(i); }
+	}
+
+	float offset = 0.0f;
+	for (auto _ : state) {
+		offset = offset > 0.0f ? -0.01f : 0.01f;
+		for (const auto primitive : changed) {
+			bounds[primitive].Min.x += offset;
+			bounds[primitive].Max.x += offset;
+		}
+		bvh.Refit(bounds, changed);
+		benchmark::DoNotOptimize(bvh.GetBounds());
+	}
+
+	state.SetItemsProcessed(state.iterations() * int64_t(changed.size()));
+}
+BENCHMARK(BM_BvhRefit)->ArgsProduct({{1'000'000}, {1, 10}})->Unit(benchmark::kMicrosecond);
+}  // namespace Luna
+
+// Parallel builds run on the engine's worker threads.
+int main(int argc, char** argv) {
+	Luna::Threading::Initialize();
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	Luna::Threading::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,163 @@
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include <Luna/Core/Filesystem.hpp>
+#include <Luna/Core/OSFilesystem.hpp>
+#include <Luna/Core/Threading.hpp>
+#include <Luna/Renderer/Scene.hpp>
+#include <iostream>
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#	include <Psapi.h>
+#else
+#	include <sys/resource.h>
+#endif
+
+// Imports a glTF file the way the renderer's loading thread does, without a window or a GPU, and prints where the time
+// went as JSON on stdout. Log output goes to stderr, so the JSON can be piped straight into other tools.
+//
+// Usage: Luna-Bench-Import <model.gltf|model.glb> [--quantized] [--textures=bc|astc|uncompressed] [--runs=N]
+namespace Luna {
+struct ImportOptions {
+	std::filesystem::path Model;
+	VertexFormat Format    = VertexFormat::Float;
+	TextureTarget Textures = TextureTarget::BC;
+	uint32_t Runs          = 1;
+};
+
+static std::optional<ImportOptions> ParseOptions(int argc, char** argv) {
+	ImportOptions options;
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg(argv[i]);
+		if (arg == "--quantized") {
+			options.Format = VertexFormat::Quantized;
+		} else if (arg == "--textures=bc") {
+			options.Textures = TextureTarget::BC;
+		} else if (arg == "--textures=astc") {
+			options.Textures = TextureTarget::ASTC;
+		} else if (arg == "--textures=uncompressed") {
+			options.Textures = TextureTarget::Uncompressed;
+		} else if (arg.starts_with("--runs=")) {
+			options.Runs = uint32_t(std::max(1, std::atoi(argv[i] + 7)));
+		} else if (!arg.starts_with("--") && options.Model.empty()) {
+			options.Model = std::filesystem::absolute(arg);
+		} else {
+			return std::nullopt;
+		}
+	}
+	if (options.Model.empty()) { return std::nullopt; }
+
+	return options;
+}
+
+/** The most memory the process has held at once, in bytes. */
+static uint64_t GetPeakMemory() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters = {};
+	if (!::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters))) { return 0; }
+
+	return counters.PeakWorkingSetSize;
+#else
+	struct rusage usage = {};
+	if (::getrusage(RUSAGE_SELF, &usage) != 0) { return 0; }
+
+#	ifdef __APPLE__
+	return uint64_t(usage.ru_maxrss);
+#	else
+	return uint64_t(usage.ru_maxrss) * 1024;
+#	endif
+#endif
+}
+
+static std::string EscapeJson(std::string_view str) {
+	std::string escaped;
+	for (const char c : str) {
+		if (c == '"' || c == '\\') { escaped += '\\'; }
+		escaped += c;
+	}
+
+	return escaped;
+}
+
+static double GetUtilization(double busyTime, double wallTime, uint32_t threadCount) {
+	return wallTime > 0.0 && threadCount > 0 ? busyTime / (wallTime * threadCount) : 0.0;
+}
+
+static std::string FormatRun(const SceneImportStats& stats) {
+	std::string json = "{\"stages\": [";
+	double busyTime  = 0.0;
+	for (size_t i = 0; i < stats.Stages.size(); ++i) {
+		const auto& stage = stats.Stages[i];
+		busyTime += stage.BusyTime;
+		json += std::format(
+			"{}{{\"name\": \"{}\", \"wall_seconds\": {:.6f}, \"busy_seconds\": {:.6f}, \"tasks\": {}, "
+			"\"utilization\": {:.3f}}}",
+			i == 0 ? "" : ", ",
+			stage.Name,
+			stage.WallTime,
+			stage.BusyTime,
+			stage.TaskCount,
+			GetUtilization(stage.BusyTime, stage.WallTime, stats.ThreadCount));
+	}
+	json += std::format("], \"wall_seconds\": {:.6f}, \"utilization\": {:.3f}, ",
+	                    stats.WallTime,
+	                    GetUtilization(busyTime, stats.WallTime, stats.ThreadCount));
+	json += std::format(
+		"\"meshes\": {}, \"nodes\": {}, \"meshlets\": {}, \"vertices\": {}, \"indices\": {}, \"triangles\": {}, "
+		"\"textures\": {}, \"texture_bytes\": {}}}",
+		stats.MeshCount,
+		stats.NodeCount,
+		stats.MeshletCount,
+		stats.VertexCount,
+		stats.IndexCount,
+		stats.TriangleCount,
+		stats.TextureCount,
+		stats.TextureBytes);
+
+	return json;
+}
+}  // namespace Luna
+
+int main(int argc, char** argv) {
+	using namespace Luna;
+
+	const auto options = ParseOptions(argc, argv);
+	if (!options) {
+		std::cerr << "Usage: Luna-Bench-Import <model.gltf|model.glb> [--quantized] "
+		             "[--textures=bc|astc|uncompressed] [--runs=N]\n";
+		return 1;
+	}
+
+	spdlog::set_default_logger(spdlog::stderr_color_mt("Luna"));
+	Threading::Initialize();
+	Filesystem::Initialize();
+	// The model is read through a protocol rooted at its own folder, so it can live anywhere on disk.
+	Filesystem::RegisterProtocol(
+		"import", std::unique_ptr<FilesystemBackend>(new OSFilesystem(Path(options->Model.parent_path()))));
+	const Path model("import://" + options->Model.filename().string());
+
+	std::vector<std::string> runs;
+	for (uint32_t run = 0; run < options->Runs; ++run) {
+		SceneImportStats stats;
+		if (!Scene::Import(model, options->Format, options->Textures, &stats)) {
+			std::cerr << "Failed to import '" << options->Model.string() << "'\n";
+			return 1;
+		}
+		runs.push_back(FormatRun(stats));
+	}
+
+	std::cout << std::format("{{\"model\": \"{}\", \"vertex_format\": \"{}\", \"threads\": {}, ",
+	                         EscapeJson(options->Model.string()),
+	                         options->Format == VertexFormat::Quantized ? "quantized" : "float",
+	                         Threading::GetThreadCount());
+	std::cout << std::format("\"peak_memory_bytes\": {}, \"runs\": [", GetPeakMemory());
+	for (size_t i = 0; i < runs.size(); ++i) { std::cout << (i == 0 ? "" : ", ") << runs[i]; }
+	std::cout << "]}\n";
+
+	Filesystem::Shutdown();
+	Threading::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include <meshoptimizer.h>
+
+#include <Luna/Renderer/Scene.hpp>
+#include <numeric>
+#include <random>
+
+// The visibility buffer pass can only be timed with a GPU and a window, so these benchmarks measure what that pass pays
+// for instead: how often vertices are re-shaded (ACMR) and how many bytes are fetched per vertex (Overfetch) when the
+// meshlets are drawn in order. The same effect shows up in-engine as the renderer's "VisBuffer" timestamp.
+namespace Luna {
+constexpr static size_t MaxMeshletIndices   = 64;
+constexpr static size_t MaxMeshletTriangles = 64;
+// Vertex cache size used when analyzing the drawn index stream, in line with the meshoptimizer defaults.
+constexpr static unsigned int VertexCacheSize = 16;
+// Bytes read per vertex by the visibility buffer pass.
+constexpr static size_t VertexFetchSize = sizeof(glm::vec3) + sizeof(QuantizedVertex);
+
+struct BenchMesh {
+	std::vector<glm::vec3> Positions;
+	std::vector<uint32_t> Indices;
+};
+
+// A grid with its triangles and vertices shuffled, standing in for an asset exported in arbitrary order. Deterministic,
+// so results are comparable between runs and machines.
+static BenchMesh MakeShuffledGrid(uint32_t size, uint64_t seed = 0x4c756e61) {
+	std::mt19937_64 rng(seed);
+	BenchMesh mesh;
+
+	const uint32_t vertexCount = (size + 1) * (size + 1);
+	std::vector<uint32_t> vertexOrder(vertexCount);
+	std::iota(vertexOrder.begin(), vertexOrder.end(), 0u);
+	std::shuffle(vertexOrder.begin(), vertexOrder.end(), rng);
+
+	mesh.Positions.resize(vertexCount);
+	for (uint32_t y = 0; y <= size; ++y) {
+		for (uint32_t x = 0; x <= size; ++x) { mesh.Positions[vertexOrder[y * (size + 1) + x]] = glm::vec3(x, y, 0); }
+	}
+
+	std::vector<std::array<uint32_t, 3>> triangles;
+	for (uint32_t y = 0; y < size; ++y) {
+		for (uint32_t x = 0; x < size; ++x) {
+			const uint32_t v0 = vertexOrder[y * (size + 1) + x];
+			const uint32_t v1 = vertexOrder[y * (size + 1) + x + 1];
+			const uint32_t v2 = vertexOrder[(y + 1) * (size + 1) + x];
+			const uint32_t v3 = vertexOrder[(y + 1) * (size + 1) + x + 1];
+			triangles.push_back({v0, v2, v1});
+			triangles.push_back({v1, v2, v3});
+		}
+	}
+	std::shuffle(triangles.begin(), triangles.end(), rng);
+	for (const auto& triangle : triangles) { mesh.Indices.insert(mesh.Indices.end(), triangle.begin(), triangle.end()); }
+
+	return mesh;
+}
+
+// Build meshlets the way Scene import does, optionally with the vertex cache, vertex fetch and meshlet optimizations,
+// and return the index stream the visibility buffer pass ends up drawing.
+static std::vector<uint32_t> BuildMeshletStream(BenchMesh mesh, bool optimize) {
+	auto& indices = mesh.Indices;
+	if (optimize) {
+		meshopt_optimizeVertexCache(indices.data(), indices.data(), indices.size(), mesh.Positions.size());
+		std::vector<uint32_t> remap(mesh.Positions.size());
+		const auto vertexCount =
+			meshopt_optimizeVertexFetchRemap(remap.data(), indices.data(), indices.size(), mesh.Positions.size());
+		meshopt_remapIndexBuffer(indices.data(), indices.data(), indices.size(), remap.data());
+		meshopt_remapVertexBuffer(
+			mesh.Positions.data(), mesh.Positions.data(), mesh.Positions.size(), sizeof(glm::vec3), remap.data());
+		mesh.Positions.resize(vertexCount);
+	}
+
+	const auto maxMeshlets = meshopt_buildMeshletsBound(indices.size(), MaxMeshletIndices, MaxMeshletTriangles);
+	std::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+	std::vector<uint32_t> meshletIndices(maxMeshlets * MaxMeshletIndices);
+	std::vector<uint8_t> meshletTriangles(maxMeshlets * MaxMeshletTriangles * 3);
+	meshlets.resize(meshopt_buildMeshlets(meshlets.data(),
+	                                      meshletIndices.data(),
+	                                      meshletTriangles.data(),
+	                                      indices.data(),
+	                                      indices.size(),
+	                                      reinterpret_cast<const float*>(mesh.Positions.data()),
+	                                      mesh.Positions.size(),
+	                                      sizeof(glm::vec3),
+	                                      MaxMeshletIndices,
+	                                      MaxMeshletTriangles,
+	                                      0.0f));
+
+	std::vector<uint32_t> stream;
+	stream.reserve(indices.size());
+	for (const auto& meshlet : meshlets) {
+		if (optimize) {
+			meshopt_optimizeMeshlet(&meshletIndices[meshlet.vertex_offset],
+			                        &meshletTriangles[meshlet.triangle_offset],
+			                        meshlet.triangle_count,
+			                        meshlet.vertex_count);
+		}
+		for (uint32_t i = 0; i < meshlet.triangle_count * 3; ++i) {
+			stream.push_back(meshletIndices[meshlet.vertex_offset + meshletTriangles[meshlet.triangle_offset + i]]);
+		}
+	}
+
+	return stream;
+}
+
+static void BM_BuildMeshlets(benchmark::State& state) {
+	const bool optimize = state.range(0) != 0;
+	const auto mesh     = MakeShuffledGrid(uint32_t(state.range(1)));
+
+	std::vector<uint32_t> stream;
+	for (auto _ : state) {
+		stream = BuildMeshletStream(mesh, optimize);
+		benchmark::DoNotOptimize(stream.data());
+	}
+
+	const auto vertexCount = mesh.Positions.size();
+	const auto cache       = meshopt_analyzeVertexCache(stream.data(), stream.size(), vertexCount, VertexCacheSize, 0, 0);
+	const auto fetch       = meshopt_analyzeVertexFetch(stream.data(), stream.size(), vertexCount, VertexFetchSize);
+	state.counters["ACMR"]      = cache.acmr;
+	state.counters["Overfetch"] = fetch.overfetch;
+	state.SetLabel(optimize ? "Optimized" : "Source order");
+}
+BENCHMARK(BM_BuildMeshlets)->ArgsProduct({{0, 1}, {128, 512}})->Unit(benchmark::kMillisecond);
+}  // namespace Luna
+
+BENCHMARK_MAIN();
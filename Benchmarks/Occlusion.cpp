@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <Luna/Renderer/OcclusionBuffer.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+// A street-level view through a grid of buildings: each building's facade is an occluder, and small props are
+// scattered between and behind them. Deterministic, so results are comparable between runs and machines.
+namespace Luna {
+constexpr static float CitySize       = 400.0f;
+constexpr static float BlockSize      = 40.0f;
+constexpr static float BuildingHeight = 25.0f;
+
+// The renderer's infinite reversed-Z projection.
+static glm::mat4 MakeViewProjection() {
+	const float tanHalfFovy = std::tan(glm::radians(70.0f) * 0.5f);
+	glm::mat4 projection(0.0f);
+	projection[0][0] = 1.0f / (tanHalfFovy * 16.0f / 9.0f);
+	projection[1][1] = 1.0f / tanHalfFovy;
+	projection[2][3] = -1.0f;
+	projection[3][2] = 0.1f;
+
+	// Standing at a crossroads, looking between the buildings on the far side of it.
+	const glm::vec3 eye(0.0f, 2.0f, 0.0f);
+
+	return projection * glm::lookAt(eye, eye + glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(0, 1, 0));
+}
+
+// Every building is a box, and every box is drawn as its four walls, two triangles each.
+static std::vector<glm::vec3> MakeBuildings() {
+	std::vector<glm::vec3> triangles;
+	for (float x = -CitySize * 0.5f; x < CitySize * 0.5f; x += BlockSize) {
+		for (float z = -CitySize * 0.5f; z < CitySize * 0.5f; z += BlockSize) {
+			const glm::vec3 min(x + BlockSize * 0.2f, 0.0f, z + BlockSize * 0.2f);
+			const glm::vec3 max(x + BlockSize * 0.8f, BuildingHeight, z + BlockSize * 0.8f);
+			const std::array<glm::vec3, 4> corners = {glm::vec3(min.x, 0.0f, min.z),
+			                                          glm::vec3(max.x, 0.0f, min.z),
+			                                          glm::vec3(max.x, 0.0f, max.z),
+			                                          glm::vec3(min.x, 0.0f, max.z)};
+			for (uint32_t i = 0; i < 4; ++i) {
+				const auto& a = corners[i];
+				const auto& b = corners[(i + 1) % 4];
+				const glm::vec3 up(0.0f, max.y, 0.0f);
+				triangles.insert(triangles.end(), {a, b, b + up, a, b + up, a + up});
+			}
+		}
+	}
+
+	return triangles;
+}
+
+static std::vector<BvhBounds> MakeProps(uint32_t count, uint64_t seed = 0x50726f70) {
+	std::mt19937_64 rng(seed);
+	std::uniform_real_distribution<float> ground(-CitySize * 0.5f, CitySize * 0.5f);
+	std::uniform_real_distribution<float> size(0.2f, 2.0f);
+
+	std::vector<BvhBounds> bounds(count);
+	for (auto& box : bounds) {
+		const glm::vec3 min(ground(rng), 0.0f, ground(rng));
+		box = {min, min + glm::vec3(size(rng), size(rng), size(rng))};
+	}
+
+	return bounds;
+}
+
+static void BM_OcclusionRender(benchmark::State& state) {
+	const auto buildings = MakeBuildings();
+	OcclusionBuffer occlusion;
+	for (auto _ : state) {
+		occlusion.Begin(MakeViewProjection());
+		occlusion.RenderOccluder(buildings, glm::mat4(1.0f));
+		benchmark::DoNotOptimize(occlusion.GetDepth().data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * int64_t(buildings.size() / 3));
+}
+BENCHMARK(BM_OcclusionRender)->Unit(benchmark::kMicrosecond);
+
+static void BM_OcclusionTest(benchmark::State& state) {
+	const auto props = MakeProps(uint32_t(state.range(0)));
+	OcclusionBuffer occlusion;
+	occlusion.Begin(MakeViewProjection());
+	occlusion.RenderOccluder(MakeBuildings(), glm::mat4(1.0f));
+
+	uint64_t visible = 0;
+	for (auto _ : state) {
+		for (const auto& box : props) { visible += occlusion.IsVisible(box); }
+	}
+
+	state.SetItemsProcessed(state.iterations() * int64_t(props.size()));
+	state.counters["Visible"] = double(visible) / double(state.iterations() * props.size());
+}
+BENCHMARK(BM_OcclusionTest)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+}  // namespace Luna
+
+BENCHMARK_MAIN();
@@ -0,0 +1,402 @@
+#include <benchmark/benchmark.h>
+
+#include <Luna/Utility/Hash.hpp>
+#include <Luna/Utility/InternedPath.hpp>
+#include <Luna/Utility/IntrusiveHashMap.hpp>
+#include <Luna/Utility/ObjectPool.hpp>
+#include <Luna/Utility/Path.hpp>
+#include <Luna/Utility/SpinLock.hpp>
+#include <Luna/Utility/StackAllocator.hpp>
+#include <Luna/Utility/TemporaryHashMap.hpp>
+#include <random>
+#include <thread>
+
+namespace Luna {
+// Contended benchmarks are run at 1, 2, 4 and 8 threads, with wall-clock time so that lock contention shows up.
+constexpr static int MaxBenchThreads = 8;
+
+struct BenchObject : IntrusiveHashMapEnabled<BenchObject> {
+	explicit BenchObject(uint64_t value = 0) : Value(value) {}
+
+	uint64_t Value;
+	uint64_t Padding[7] = {};
+};
+
+struct BenchTemporaryObject : TemporaryHashMapEnabled<BenchTemporaryObject>,
+                              IntrusiveListEnabled<BenchTemporaryObject> {
+	uint64_t Value = 0;
+};
+
+// Deterministic keys, so results are comparable between runs and machines.
+static std::vector<Hash> MakeKeys(size_t count, uint64_t seed = 0x4c756e61) {
+	std::mt19937_64 rng(seed);
+	std::vector<Hash> keys(count);
+	for (auto& key : keys) { key = rng(); }
+
+	return keys;
+}
+
+/* ==================
+** ===== Hasher =====
+*  ================== */
+
+static void BM_HasherData(benchmark::State& state) {
+	const std::vector<uint8_t> data(size_t(state.range(0)), 0xa5);
+	for (auto _ : state) {
+		Hasher h;
+		h.Data(data.size(), data.data());
+		benchmark::DoNotOptimize(h.Get());
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_HasherData)->RangeMultiplier(4)->Range(16, 16384);
+
+static void BM_HasherString(benchmark::State& state) {
+	const std::string str(size_t(state.range(0)), 'x');
+	for (auto _ : state) {
+		Hasher h(str);
+		benchmark::DoNotOptimize(h.Get());
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_HasherString)->RangeMultiplier(4)->Range(16, 1024);
+
+/* ============================
+** ===== IntrusiveHashMap =====
+*  ============================ */
+
+static void BM_IntrusiveHashMapInsert(benchmark::State& state) {
+	const auto keys = MakeKeys(size_t(state.range(0)));
+	for (auto _ : state) {
+		IntrusiveHashMap<BenchObject> map;
+		for (const auto key : keys) { map.EmplaceYield(key, key); }
+		benchmark::DoNotOptimize(map.Find(keys.front()));
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_IntrusiveHashMapInsert)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_IntrusiveHashMapFind(benchmark::State& state) {
+	const auto keys = MakeKeys(size_t(state.range(0)));
+	IntrusiveHashMap<BenchObject> map;
+	for (const auto key : keys) { map.EmplaceYield(key, key); }
+
+	size_t index = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(map.Find(keys[index]));
+		if (++index == keys.size()) { index = 0; }
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_IntrusiveHashMapFind)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_IntrusiveHashMapFindMiss(benchmark::State& state) {
+	const auto keys   = MakeKeys(size_t(state.range(0)));
+	const auto misses = MakeKeys(size_t(state.range(0)), 0x6d697373);
+	IntrusiveHashMap<BenchObject> map;
+	for (const auto key : keys) { map.EmplaceYield(key, key); }
+
+	size_t index = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(map.Find(misses[index]));
+		if (++index == misses.size()) { index = 0; }
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_IntrusiveHashMapFindMiss)->RangeMultiplier(8)->Range(64, 32768);
+
+// Shared state for the contended hash map benchmarks. Thread 0 sets it up before the first iteration and tears it down
+// after the last; the benchmark library synchronizes all threads around the timed loop.
+static std::vector<Hash> SharedKeys;
+static ThreadSafeIntrusiveHashMap<BenchObject>* SharedMap = nullptr;
+static ThreadSafeIntrusiveHashMapReadCached<BenchObject>* SharedCachedMap = nullptr;
+
+// Mostly reads with an occasional insert, the access pattern of the Vulkan object caches.
+static void BM_ThreadSafeIntrusiveHashMap(benchmark::State& state) {
+	constexpr size_t KeyCount = 4096;
+	if (state.thread_index() == 0) {
+		SharedKeys = MakeKeys(KeyCount * 2);
+		SharedMap  = new ThreadSafeIntrusiveHashMap<BenchObject>();
+		for (size_t i = 0; i < KeyCount; ++i) { SharedMap->EmplaceYield(SharedKeys[i], SharedKeys[i]); }
+	}
+
+	const auto writePercent = size_t(state.range(0));
+	size_t index            = size_t(state.thread_index()) * 97;
+	for (auto _ : state) {
+		const auto key = SharedKeys[index % SharedKeys.size()];
+		if ((index % 100) < writePercent) {
+			benchmark::DoNotOptimize(SharedMap->EmplaceYield(key, key));
+		} else {
+			benchmark::DoNotOptimize(SharedMap->Find(key));
+		}
+		++index;
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+
+	if (state.thread_index() == 0) {
+		delete SharedMap;
+		SharedMap = nullptr;
+	}
+}
+BENCHMARK(BM_ThreadSafeIntrusiveHashMap)
+  ->ArgName("WritePct")
+  ->Arg(0)
+  ->Arg(1)
+  ->Arg(10)
+  ->ThreadRange(1, MaxBenchThreads)
+  ->UseRealTime();
+
+static void BM_ThreadSafeIntrusiveHashMapReadCached(benchmark::State& state) {
+	constexpr size_t KeyCount = 4096;
+	if (state.thread_index() == 0) {
+		SharedKeys      = MakeKeys(KeyCount);
+		SharedCachedMap = new ThreadSafeIntrusiveHashMapReadCached<BenchObject>();
+		for (const auto key : SharedKeys) { SharedCachedMap->EmplaceYield(key, key); }
+		SharedCachedMap->MoveToReadOnly();
+	}
+
+	size_t index = size_t(state.thread_index()) * 97;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(SharedCachedMap->Find(SharedKeys[index % SharedKeys.size()]));
+		++index;
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+
+	if (state.thread_index() == 0) {
+		delete SharedCachedMap;
+		SharedCachedMap = nullptr;
+	}
+}
+BENCHMARK(BM_ThreadSafeIntrusiveHashMapReadCached)->ThreadRange(1, MaxBenchThreads)->UseRealTime();
+
+/* ============================
+** ===== TemporaryHashMap =====
+*  ============================ */
+
+// One simulated frame: advance the ring, then request a working set of which a fraction is new each frame.
+template <bool ReuseObjects>
+static void BM_TemporaryHashMapFrame(benchmark::State& state) {
+	const auto workingSet = size_t(state.range(0));
+	const auto keys       = MakeKeys(workingSet * 4);
+	TemporaryHashMap<BenchTemporaryObject, 4, ReuseObjects> map;
+
+	size_t frame = 0;
+	for (auto _ : state) {
+		map.BeginFrame();
+		const size_t base = (frame++ * workingSet / 8) % (keys.size() - workingSet);
+		for (size_t i = 0; i < workingSet; ++i) {
+			const auto key = keys[base + i];
+			auto* node     = map.Request(key);
+			if (!node && ReuseObjects) { node = map.RequestVacant(key); }
+			if (!node) { node = map.Emplace(key); }
+			benchmark::DoNotOptimize(node);
+		}
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_TemporaryHashMapFrame<false>)->Arg(64)->Arg(1024);
+BENCHMARK(BM_TemporaryHashMapFrame<true>)->Arg(64)->Arg(1024);
+
+/* ======================
+** ===== ObjectPool =====
+*  ====================== */
+
+static void BM_ObjectPool(benchmark::State& state) {
+	const auto batch = size_t(state.range(0));
+	ObjectPool<BenchObject> pool;
+	std::vector<BenchObject*> objects(batch);
+	for (auto _ : state) {
+		for (auto& object : objects) { object = pool.Allocate(); }
+		for (auto* object : objects) { pool.Free(object); }
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ObjectPool)->Arg(16)->Arg(256);
+
+static ThreadSafeObjectPool<BenchObject>* SharedPool = nullptr;
+
+static void BM_ThreadSafeObjectPool(benchmark::State& state) {
+	if (state.thread_index() == 0) { SharedPool = new ThreadSafeObjectPool<BenchObject>(); }
+
+	const auto batch = size_t(state.range(0));
+	std::vector<BenchObject*> objects(batch);
+	for (auto _ : state) {
+		for (auto& object : objects) { object = SharedPool->Allocate(); }
+		for (auto* object : objects) { SharedPool->Free(object); }
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+
+	if (state.thread_index() == 0) {
+		delete SharedPool;
+		SharedPool = nullptr;
+	}
+}
+BENCHMARK(BM_ThreadSafeObjectPool)->Arg(16)->Arg(256)->ThreadRange(1, MaxBenchThreads)->UseRealTime();
+
+/* ==========================
+** ===== StackAllocator =====
+*  ========================== */
+
+static void BM_StackAllocator(benchmark::State& state) {
+	const auto count = size_t(state.range(0));
+	StackAllocator<uint32_t, 4096> allocator;
+	for (auto _ : state) {
+		for (size_t i = 0; i < 4096 / count; ++i) { benchmark::DoNotOptimize(allocator.Allocate(count)); }
+		allocator.Reset();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * (4096 / state.range(0)));
+}
+BENCHMARK(BM_StackAllocator)->Arg(1)->Arg(16)->Arg(256);
+
+static void BM_StackAllocatorCleared(benchmark::State& state) {
+	const auto count = size_t(state.range(0));
+	StackAllocator<uint32_t, 4096> allocator;
+	for (auto _ : state) {
+		for (size_t i = 0; i < 4096 / count; ++i) { benchmark::DoNotOptimize(allocator.AllocateCleared(count)); }
+		allocator.Reset();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * (4096 / state.range(0)));
+}
+BENCHMARK(BM_StackAllocatorCleared)->Arg(1)->Arg(16)->Arg(256);
+
+/* ======================
+** ===== RWSpinLock =====
+*  ====================== */
+
+static RWSpinLock SharedLock;
+static uint64_t SharedCounter = 0;
+
+static void BM_RWSpinLock(benchmark::State& state) {
+	const auto writePercent = size_t(state.range(0));
+	size_t index            = size_t(state.thread_index()) * 37;
+	for (auto _ : state) {
+		if ((index++ % 100) < writePercent) {
+			SharedLock.LockWrite();
+			++SharedCounter;
+			SharedLock.UnlockWrite();
+		} else {
+			SharedLock.LockRead();
+			benchmark::DoNotOptimize(SharedCounter);
+			SharedLock.UnlockRead();
+		}
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_RWSpinLock)
+  ->ArgName("WritePct")
+  ->Arg(0)
+  ->Arg(10)
+  ->Arg(50)
+  ->ThreadRange(1, MaxBenchThreads)
+  ->UseRealTime();
+
+/* ================
+** ===== Path =====
+*  ================ */
+
+static const std::vector<std::string> BenchPaths = {"res://Shaders/Common.glsli",
+                                                    "res://Shaders/VisBuffer/CullMeshlets.comp.glsl",
+                                                    "res://Models/Bistro.glb",
+                                                    "cache://Shaders/0123456789abcdef.spv",
+                                                    "assets/textures/../textures/./albedo.ktx2"};
+
+static void BM_PathConstruct(benchmark::State& state) {
+	size_t index = 0;
+	for (auto _ : state) {
+		Path path(BenchPaths[index++ % BenchPaths.size()]);
+		benchmark::DoNotOptimize(path);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_PathConstruct);
+
+static void BM_PathComponents(benchmark::State& state) {
+	std::vector<Path> paths(BenchPaths.begin(), BenchPaths.end());
+	size_t index = 0;
+	for (auto _ : state) {
+		const auto& path = paths[index++ % paths.size()];
+		benchmark::DoNotOptimize(path.Protocol());
+		benchmark::DoNotOptimize(path.Filename());
+		benchmark::DoNotOptimize(path.Extension());
+		benchmark::DoNotOptimize(path.ParentPath());
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_PathComponents);
+
+static void BM_PathNormalized(benchmark::State& state) {
+	std::vector<Path> paths(BenchPaths.begin(), BenchPaths.end());
+	size_t index = 0;
+	for (auto _ : state) {
+		auto normalized = paths[index++ % paths.size()].Normalized();
+		benchmark::DoNotOptimize(normalized);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_PathNormalized);
+
+static void BM_PathAppend(benchmark::State& state) {
+	const Path base("res://Shaders");
+	for (auto _ : state) {
+		auto path = base / "VisBuffer" / "CullMeshlets.comp.glsl";
+		benchmark::DoNotOptimize(path);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_PathAppend);
+
+// Lookup cost of a Path-keyed map, which rehashes and compares the full string on every find.
+static void BM_PathMapLookup(benchmark::State& state) {
+	std::vector<Path> paths(BenchPaths.begin(), BenchPaths.end());
+	std::unordered_map<Path, int> map;
+	for (size_t i = 0; i < paths.size(); ++i) { map[paths[i]] = int(i); }
+
+	size_t index = 0;
+	for (auto _ : state) { benchmark::DoNotOptimize(map.find(paths[index++ % paths.size()])); }
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_PathMapLookup);
+
+// The same lookup keyed by already-interned paths, which uses the stored hash and pointer equality.
+static void BM_InternedPathMapLookup(benchmark::State& state) {
+	std::vector<InternedPath> paths(BenchPaths.begin(), BenchPaths.end());
+	std::unordered_map<InternedPath, int> map;
+	for (size_t i = 0; i < paths.size(); ++i) { map[paths[i]] = int(i); }
+
+	size_t index = 0;
+	for (auto _ : state) { benchmark::DoNotOptimize(map.find(paths[index++ % paths.size()])); }
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_InternedPathMapLookup);
+
+// Interning an existing path from many threads at once, which exercises the sharded intern table.
+static void BM_InternedPathIntern(benchmark::State& state) {
+	size_t index = size_t(state.thread_index());
+	for (auto _ : state) {
+		InternedPath path(BenchPaths[index++ % BenchPaths.size()]);
+		benchmark::DoNotOptimize(path);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_InternedPathIntern)->ThreadRange(1, MaxBenchThreads)->UseRealTime();
+}  // namespace Luna
+
+int main(int argc, char** argv) {
+	// Default to JSON on stdout so results can be diffed and consumed by tooling. An explicit format flag still wins.
+	std::vector<char*> args(argv, argv + argc);
+	const bool hasFormat = std::any_of(args.begin() + 1, args.end(), [](const char* arg) {
+		return std::string_view(arg).starts_with("--benchmark_format");
+	});
+	std::string jsonFormat = "--benchmark_format=json";
+	if (!hasFormat) { args.push_back(jsonFormat.data()); }
+
+	benchmark::AddCustomContext("hardware_threads", std::to_string(std::thread::hardware_concurrency()));
+
+	int count = int(args.size());
+	benchmark::Initialize(&count, args.data());
+	if (benchmark::ReportUnrecognizedArguments(count, args.data())) { return 1; }
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -14,7 +14,7 @@ enum class PathType { File, Directory, Special };
 using FileNotifyHandle = int;
 
 struct FileNotifyInfo {
-	Path Path;
+	Luna::Path Path;
 	FileNotifyType Type;
 	FileNotifyHandle Handle;
 };
@@ -26,7 +26,7 @@ struct FileStat {
 };
 
 struct ListEntry {
-	Path Path;
+	Luna::Path Path;
 	PathType Type;
 };
 
@@ -139,6 +139,15 @@ class ScratchFilesystem : public FilesystemBackend {
  private:
 	using ScratchFile = std::vector<uint8_t>;
 
-	std::unordered_map<Path, std::unique_ptr<ScratchFile>> _files;
+	// Files are transient, so they are keyed by plain strings rather than interned paths, which would outlive them.
+	struct FileHash {
+		using is_transparent = void;
+
+		size_t operator()(std::string_view path) const noexcept {
+			return std::hash<std::string_view>{}(path);
+		}
+	};
+
+	std::unordered_map<std::string, std::unique_ptr<ScratchFile>, FileHash, std::equal_to<>> _files;
 };
 }  // namespace Luna
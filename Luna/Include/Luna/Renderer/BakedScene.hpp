@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Luna/Renderer/Scene.hpp>
+
+namespace Luna {
+/**
+ * On-disk layout of a baked scene (.lunascene).
+ *
+ * A baked scene holds the final, GPU-ready arrays produced by importing a glTF file, so loading one only needs to map
+ * the file and upload each section as-is. The file begins with a BakedSceneHeader, followed by each section at an
+ * offset aligned to BakedSceneAlignment. All values are stored little-endian.
+ *
+ * Any change to the layout of the header, the section contents, Vertex, or Meshlet must bump BakedSceneVersion.
+ */
+constexpr static uint32_t BakedSceneMagic   = 0x4e43534c;  // "LSCN"
+constexpr static uint32_t BakedSceneVersion = 6;
+// Matches the largest minStorageBufferOffsetAlignment permitted by Vulkan, so the file can also be uploaded as a
+// single buffer and each section bound at its file offset.
+constexpr static uint64_t BakedSceneAlignment = 256;
+
+enum class BakedSceneSection : uint32_t {
+	Positions,     /** glm::vec3 per vertex. */
+	Vertices,      /** Vertex or QuantizedVertex per vertex, as given by the header's VertexFormat. */
+	Indices,       /** uint32_t meshlet vertex indices. */
+	Triangles,     /** uint8_t meshlet triangle indices. */
+	Meshlets,      /** Meshlet, grouped by mesh. */
+	Meshes,        /** BakedMesh per mesh. */
+	Nodes,         /** BakedNode per node. */
+	NodeChildren,  /** uint32_t child node indices, referenced by BakedNode. */
+	RootNodes,     /** uint32_t root node indices. */
+	Count
+};
+constexpr static size_t BakedSceneSectionCount = size_t(BakedSceneSection::Count);
+
+constexpr static uint32_t BakedSceneInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+struct BakedSceneSectionInfo {
+	uint64_t Offset;
+	uint64_t Size;
+};
+
+struct BakedSceneHeader {
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t VertexStride;
+	uint32_t MeshletStride;
+	VertexFormat VertexFormat;
+	uint32_t Reserved;
+	uint64_t SourceModified; /** Modification time of the source file, used to detect a stale bake. */
+	uint64_t FileSize;
+	std::array<BakedSceneSectionInfo, BakedSceneSectionCount> Sections;
+};
+
+struct BakedMesh {
+	uint32_t MeshletOffset;
+	uint32_t MeshletCount;
+};
+
+struct BakedNode {
+	glm::mat4 Transform;
+	uint32_t Parent; /** BakedSceneInvalidIndex for root nodes. */
+	uint32_t Mesh;   /** BakedSceneInvalidIndex for nodes without a mesh. */
+	uint32_t ChildOffset;
+	uint32_t ChildCount;
+};
+
+static_assert(std::is_trivially_copyable_v<BakedSceneHeader>);
+static_assert(std::is_trivially_copyable_v<BakedMesh>);
+static_assert(std::is_trivially_copyable_v<BakedNode>);
+static_assert(std::is_trivially_copyable_v<Vertex>);
+static_assert(std::is_trivially_copyable_v<QuantizedVertex>);
+static_assert(std::is_trivially_copyable_v<Meshlet>);
+}  // namespace Luna
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <Luna/Common.hpp>
+#include <Luna/Utility/BitOps.hpp>
+
+namespace Luna {
+struct BvhBounds {
+	glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+	glm::vec3 Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+	[[nodiscard]] bool Empty() const noexcept {
+		return Min.x > Max.x;
+	}
+	[[nodiscard]] glm::vec3 Center() const noexcept {
+		return (Min + Max) * 0.5f;
+	}
+	[[nodiscard]] float SurfaceArea() const noexcept {
+		const auto extent = Max - Min;
+
+		return Empty() ? 0.0f : 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+	}
+
+	void Extend(const glm::vec3& point) noexcept {
+		Min = glm::min(Min, point);
+		Max = glm::max(Max, point);
+	}
+	void Extend(const BvhBounds& other) noexcept {
+		Min = glm::min(Min, other.Min);
+		Max = glm::max(Max, other.Max);
+	}
+
+	/** The axis-aligned box which encloses this box after the given affine transform. */
+	[[nodiscard]] BvhBounds Transform(const glm::mat4& transform) const noexcept;
+
+	[[nodiscard]] bool operator==(const BvhBounds& other) const noexcept = default;
+};
+
+/**
+ * A bounding volume hierarchy over axis-aligned boxes, with four children per node.
+ *
+ * The tree is built top-down with the binned surface area heuristic. Each node stores the bounds of its four children
+ * side by side, so a ray or frustum is tested against all of them at once with SIMD. Leaves hold up to LeafSize
+ * primitives, which are referred to by their index in the bounds the tree was built from.
+ *
+ * When primitives move, Refit() updates only the boxes above them. The tree's shape does not change, so a tree which
+ * has been refit after large movements answers queries more slowly than a fresh Build() would.
+ */
+class Bvh {
+ public:
+	constexpr static uint32_t LeafSize = 4;
+
+	/**
+	 * Build over the given primitive bounds, or over the subset of them given by index.
+	 *
+	 * If parallel is set, a large build is split into subtrees which are built on worker threads, and this blocks until
+	 * they are done.
+	 */
+	void Build(std::span<const BvhBounds> bounds, bool parallel = false);
+	void Build(std::span<const BvhBounds> bounds, std::span<const uint32_t> primitives, bool parallel = false);
+	void Clear();
+	/** Update the tree for the listed primitives, whose bounds have changed since the last Build() or Refit(). */
+	void Refit(std::span<const BvhBounds> bounds, std::span<const uint32_t> changed);
+
+	[[nodiscard]] bool Empty() const noexcept {
+		return _nodes.empty();
+	}
+	[[nodiscard]] const BvhBounds& GetBounds() const noexcept {
+		return _bounds;
+	}
+	[[nodiscard]] size_t GetNodeCount() const noexcept {
+		return _nodes.size();
+	}
+
+	/**
+	 * Visit every primitive whose bounds the ray enters within maxDistance, nearer children first.
+	 *
+	 * The visitor is called as visitor(primitive, maxDistance), and may shorten maxDistance, such as when it finds a hit,
+	 * to skip everything further away. Distances are in multiples of direction, which need not be normalized.
+	 */
+	template <typename F>
+	void Intersect(const glm::vec3& origin, const glm::vec3& direction, float& maxDistance, F&& visitor) const;
+	/**
+	 * Visit every primitive whose bounds are at least partly inside the frustum.
+	 *
+	 * Planes are given as the renderer culls with them: a point p is inside when dot(plane.xyz, p) >= plane.w.
+	 */
+	template <typename F>
+	void Intersect(std::span<const glm::vec4, 6> planes, F&& visitor) const;
+
+ private:
+	constexpr static uint32_t Invalid = std::numeric_limits<uint32_t>::max();
+	/** No tree is deeper than this, which sizes the traversal stacks. Each level adds at most 3 entries to them. */
+	constexpr static uint32_t MaxDepth = 64;
+
+	/** Four children, with their bounds stored per component so they are loaded straight into SIMD registers. */
+	struct alignas(16) Node {
+		float MinX[4];
+		float MinY[4];
+		float MinZ[4];
+		float MaxX[4];
+		float MaxY[4];
+		float MaxZ[4];
+		uint32_t Children[4]; /** A node index, or for a leaf, the leaf's first entry in _primitives. */
+		uint32_t Counts[4];   /** Primitive count of a leaf, or 0 for a node. */
+		uint32_t ChildCount;
+	};
+	struct BuildContext;
+	struct BuildRange;
+
+	uint32_t BuildNode(BuildContext& context, const BuildRange& range, bool defer);
+	static bool SetChildBounds(Node& node, uint32_t child, const BvhBounds& bounds);
+	static BvhBounds GetNodeBounds(const Node& node);
+	/** Test a ray against a node's children. Returns a mask of the children hit, and their entry distances. */
+	static uint32_t IntersectNode(const Node& node,
+	                              const glm::vec3& origin,
+	                              const glm::vec3& inverseDirection,
+	                              float maxDistance,
+	                              float* distances);
+	/** Test a frustum against a node's children. Returns a mask of the children at least partly inside. */
+	static uint32_t IntersectNode(const Node& node, std::span<const glm::vec4, 6> planes);
+
+	std::vector<Node> _nodes;
+	std::vector<uint32_t> _primitives; /** Primitive indices, grouped by leaf. */
+	std::vector<uint32_t> _parents;    /** The slot (node * 4 + child) which refers to each node. */
+	std::vector<uint32_t> _leafSlots;  /** The slot of the leaf holding each primitive. */
+	BvhBounds _bounds;
+};
+
+template <typename F>
+void Bvh::Intersect(const glm::vec3& origin, const glm::vec3& direction, float& maxDistance, F&& visitor) const {
+	if (_nodes.empty()) { return; }
+
+	const glm::vec3 inverseDirection = 1.0f / direction;
+
+	struct Entry {
+		uint32_t Node;
+		float Distance;
+	};
+	std::array<Entry, 3 * MaxDepth + 1> stack;
+	uint32_t stackSize = 0;
+	stack[stackSize++] = {0, 0.0f};
+	while (stackSize > 0) {
+		const auto entry = stack[--stackSize];
+		if (entry.Distance > maxDistance) { continue; }
+
+		const auto& node = _nodes[entry.Node];
+		alignas(16) float distances[4];
+		uint32_t hits = IntersectNode(node, origin, inverseDirection, maxDistance, distances);
+
+		// Sort the children farthest first.
+		uint32_t order[4];
+		uint32_t orderCount = 0;
+		while (hits) {
+			const uint32_t child = TrailingZeroes(hits);
+			hits &= hits - 1;
+			uint32_t i = orderCount++;
+			while (i > 0 && distances[order[i - 1]] < distances[child]) {
+				order[i] = order[i - 1];
+				--i;
+			}
+			order[i] = child;
+		}
+		// Leaves are visited nearest first, so their hits can rule out the farther ones before they are scanned.
+		for (uint32_t i = orderCount; i-- > 0;) {
+			const auto child = order[i];
+			if (node.Counts[child] == 0 || distances[child] > maxDistance) { continue; }
+			for (uint32_t p = 0; p < node.Counts[child]; ++p) {
+				visitor(_primitives[node.Children[child] + p], maxDistance);
+			}
+		}
+		// Nodes are pushed farthest first, so the nearest one is popped next.
+		for (uint32_t i = 0; i < orderCount; ++i) {
+			const auto child = order[i];
+			if (node.Counts[child] == 0) { stack[stackSize++] = {node.Children[child], distances[child]}; }
+		}
+	}
+}
+
+template <typename F>
+void Bvh::Intersect(std::span<const glm::vec4, 6> planes, F&& visitor) const {
+	if (_nodes.empty()) { return; }
+
+	std::array<uint32_t, 3 * MaxDepth + 1> stack;
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0) {
+		const auto& node = _nodes[stack[--stackSize]];
+		uint32_t inside  = IntersectNode(node, planes);
+		while (inside) {
+			const uint32_t child = TrailingZeroes(inside);
+			inside &= inside - 1;
+			if (node.Counts[child] == 0) {
+				stack[stackSize++] = node.Children[child];
+			} else {
+				for (uint32_t p = 0; p < node.Counts[child]; ++p) { visitor(_primitives[node.Children[child] + p]); }
+			}
+		}
+	}
+}
+}  // namespace Luna
@@ -5,6 +5,8 @@
 #include <Luna/Vulkan/Common.hpp>
 
 namespace Luna {
+class GeometryArena;
+class OcclusionBuffer;
 class Renderer;
 class RenderGraph;
 class RenderPass;
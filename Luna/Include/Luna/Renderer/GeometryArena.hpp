@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Luna/Renderer/Common.hpp>
+#include <Luna/Utility/OffsetAllocator.hpp>
+#include <Luna/Utility/SlotMap.hpp>
+
+namespace Luna {
+enum class VertexFormat : uint32_t;
+
+/**
+ * Device buffers which hold the geometry of every loaded model, so that any number of models can be resident at once
+ * while the renderer binds the same buffers for its whole lifetime.
+ *
+ * Each model allocates one range per stream, suballocated with an OffsetAllocator. Vertex ranges cover both the
+ * position and the attribute buffer, since meshlets index the two together. The buffers are sized once at creation,
+ * so loading or unloading a model never reallocates them; an allocation which does not fit fails instead.
+ */
+class GeometryArena {
+ public:
+	enum class Stream : uint32_t { Vertices, Indices, Triangles, Meshlets, Count };
+	constexpr static size_t StreamCount = size_t(Stream::Count);
+	using StreamSizes                   = std::array<uint32_t, StreamCount>;
+
+	/** The ranges owned by one model, in elements of each stream's buffer. */
+	struct Allocation {
+		StreamSizes Offsets = {};
+		StreamSizes Counts  = {};
+
+		// Internal. The allocator ranges backing Offsets and Counts.
+		std::array<OffsetAllocator::Allocation, StreamCount> Ranges = {};
+	};
+	using Handle = SlotHandle<Allocation>;
+
+	/** Create the arena's buffers, large enough for the given number of elements of each stream. */
+	GeometryArena(VertexFormat format, const StreamSizes& capacities);
+	GeometryArena(const GeometryArena&)            = delete;
+	GeometryArena& operator=(const GeometryArena&) = delete;
+
+	[[nodiscard]] Vulkan::Buffer& GetPositionBuffer() {
+		return *_positionBuffer;
+	}
+	[[nodiscard]] Vulkan::Buffer& GetVertexBuffer() {
+		return *_vertexBuffer;
+	}
+	[[nodiscard]] Vulkan::Buffer& GetIndexBuffer() {
+		return *_indexBuffer;
+	}
+	[[nodiscard]] Vulkan::Buffer& GetTriangleBuffer() {
+		return *_triangleBuffer;
+	}
+	[[nodiscard]] Vulkan::Buffer& GetMeshletBuffer() {
+		return *_meshletBuffer;
+	}
+	[[nodiscard]] VertexFormat GetVertexFormat() const noexcept {
+		return _vertexFormat;
+	}
+	/** Incremented every time Defragment() moves allocations. Owners compare against it to notice their data moved. */
+	[[nodiscard]] uint32_t GetGeneration() const noexcept {
+		return _generation;
+	}
+	[[nodiscard]] OffsetAllocator::StorageReport GetStorageReport(Stream stream) const {
+		return _allocators[size_t(stream)].GetStorageReport();
+	}
+
+	/** Allocate ranges of the given sizes, all or nothing. Returns an invalid handle if any stream is out of space. */
+	[[nodiscard]] Handle Allocate(const StreamSizes& counts);
+	/** The current ranges of an allocation, or nullptr for an invalid handle. */
+	[[nodiscard]] const Allocation* Find(Handle handle) const {
+		return _allocations.Find(handle);
+	}
+	/**
+	 * Release an allocation. Frames already submitted may still read from it, so its ranges only become available again
+	 * once those frames have completed.
+	 */
+	void Free(Handle handle);
+	/** Make the ranges freed by the frame which last used the current frame context available again. */
+	void BeginFrame();
+
+	/**
+	 * Move every allocation towards the start of its buffers, closing the gaps left by freed models.
+	 *
+	 * This waits for the device to go idle before and after copying, so it must only be called when a stall is
+	 * acceptable, such as after a failed allocation. Any model whose ranges moved must rewrite data which refers to its
+	 * own offsets, which its owner detects through GetGeneration(). Returns true if anything moved.
+	 */
+	bool Defragment();
+
+ private:
+	void ReleaseFrees(std::vector<Handle>& frees);
+
+	VertexFormat _vertexFormat;
+	uint32_t _vertexStride;
+	Vulkan::BufferHandle _positionBuffer;
+	Vulkan::BufferHandle _vertexBuffer;
+	Vulkan::BufferHandle _indexBuffer;
+	Vulkan::BufferHandle _triangleBuffer;
+	Vulkan::BufferHandle _meshletBuffer;
+
+	std::array<OffsetAllocator, StreamCount> _allocators;
+	SlotMap<Allocation> _allocations;
+	std::vector<std::vector<Handle>> _pendingFrees; /** Handles freed during each frame context. */
+	uint32_t _generation = 0;
+};
+}  // namespace Luna
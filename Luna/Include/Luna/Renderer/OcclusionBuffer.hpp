@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Luna/Renderer/Bvh.hpp>
+
+namespace Luna {
+/**
+ * A small software depth buffer, for culling whole instances on the CPU before they reach the GPU.
+ *
+ * Each frame, a handful of occluder meshes are rasterized into it, then instance bounds are tested against the result.
+ * Unlike the GPU's Hi-Z test, which reuses the previous frame's depth, this only ever sees the current camera, so it
+ * cannot miss disocclusions.
+ *
+ * Depth is stored in the renderer's reversed-Z convention, and kept conservative: a triangle only writes the pixels it
+ * covers entirely, each pixel holds the farthest depth its occluders reach anywhere inside it, and a box is tested
+ * against every pixel it touches. A box is therefore only reported hidden if it lies entirely behind occluders. The
+ * price is that pixels split between two triangles of the same mesh stay empty, so occluders should be meshes with
+ * large triangles.
+ *
+ * Rows are processed 8 pixels at a time with AVX2 on x86 CPUs which support it, checked once at runtime, and one pixel
+ * at a time otherwise.
+ */
+class OcclusionBuffer {
+ public:
+	constexpr static uint32_t Width  = 320;
+	constexpr static uint32_t Height = 192;
+
+	OcclusionBuffer();
+
+	/** Clear the buffer, and set the camera which the following calls render and test with. */
+	void Begin(const glm::mat4& viewProjection);
+	/** Rasterize a triangle list, whose positions are given in the space which transform maps to world space. */
+	void RenderOccluder(std::span<const glm::vec3> triangles, const glm::mat4& transform);
+	/** Returns false only if the world-space box is off screen, or hidden behind the occluders rendered since Begin(). */
+	[[nodiscard]] bool IsVisible(const BvhBounds& bounds) const;
+
+	/** Depth per pixel, row by row. Zero where no occluder was rendered. */
+	[[nodiscard]] std::span<const float> GetDepth() const noexcept {
+		return _depth;
+	}
+
+ private:
+	void RasterizeTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2);
+
+	glm::mat4 _viewProjection = glm::mat4(1.0f);
+	std::vector<float> _depth;
+};
+}  // namespace Luna
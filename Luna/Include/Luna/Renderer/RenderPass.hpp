@@ -2,6 +2,7 @@
 
 #include <Luna/Core/Threading.hpp>
 #include <Luna/Renderer/Common.hpp>
+#include <Luna/Utility/SmallVector.hpp>
 
 namespace Luna {
 /**
@@ -100,6 +101,11 @@ class RenderPass {
 		RenderTextureResource* Texture = nullptr;
 	};
 
+	// Passes rarely touch more than a few resources of each kind, so these lists are kept inline to avoid allocating for
+	// every pass.
+	using BufferList  = SmallVector<RenderBufferResource*, 8>;
+	using TextureList = SmallVector<RenderTextureResource*, 8>;
+
 	RenderPass(RenderGraph& graph, uint32_t index, RenderGraphQueueFlagBits queue);
 
 	[[nodiscard]] RenderGraph& GetGraph() noexcept {
@@ -131,32 +137,32 @@ class RenderPass {
 		return _proxyOutputs;
 	}
 
-	[[nodiscard]] const std::vector<RenderBufferResource*>& GetStorageInputs() const noexcept {
+	[[nodiscard]] const BufferList& GetStorageInputs() const noexcept {
 		return _storageInputs;
 	}
-	[[nodiscard]] const std::vector<RenderBufferResource*>& GetStorageOutputs() const noexcept {
+	[[nodiscard]] const BufferList& GetStorageOutputs() const noexcept {
 		return _storageOutputs;
 	}
-	[[nodiscard]] const std::vector<RenderBufferResource*>& GetTransferOutputs() const noexcept {
+	[[nodiscard]] const BufferList& GetTransferOutputs() const noexcept {
 		return _transferOutputs;
 	}
 
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetAttachmentInputs() const noexcept {
+	[[nodiscard]] const TextureList& GetAttachmentInputs() const noexcept {
 		return _attachmentInputs;
 	}
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetBlitTextureInputs() const noexcept {
+	[[nodiscard]] const TextureList& GetBlitTextureInputs() const noexcept {
 		return _blitTextureInputs;
 	}
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetBlitTextureOutputs() const noexcept {
+	[[nodiscard]] const TextureList& GetBlitTextureOutputs() const noexcept {
 		return _blitTextureOutputs;
 	}
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetColorInputs() const noexcept {
+	[[nodiscard]] const TextureList& GetColorInputs() const noexcept {
 		return _colorInputs;
 	}
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetColorOutputs() const noexcept {
+	[[nodiscard]] const TextureList& GetColorOutputs() const noexcept {
 		return _colorOutputs;
 	}
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetColorScaleInputs() const noexcept {
+	[[nodiscard]] const TextureList& GetColorScaleInputs() const noexcept {
 		return _colorScaleInputs;
 	}
 	[[nodiscard]] RenderTextureResource* GetDepthStencilInput() const noexcept {
@@ -165,16 +171,16 @@ class RenderPass {
 	[[nodiscard]] RenderTextureResource* GetDepthStencilOutput() const noexcept {
 		return _depthStencilOutput;
 	}
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetHistoryInputs() const noexcept {
+	[[nodiscard]] const TextureList& GetHistoryInputs() const noexcept {
 		return _historyInputs;
 	}
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetResolveOutputs() const noexcept {
+	[[nodiscard]] const TextureList& GetResolveOutputs() const noexcept {
 		return _resolveOutputs;
 	}
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetStorageTextureInputs() const noexcept {
+	[[nodiscard]] const TextureList& GetStorageTextureInputs() const noexcept {
 		return _storageTextureInputs;
 	}
-	[[nodiscard]] const std::vector<RenderTextureResource*>& GetStorageTextureOutputs() const noexcept {
+	[[nodiscard]] const TextureList& GetStorageTextureOutputs() const noexcept {
 		return _storageTextureOutputs;
 	}
 
@@ -249,22 +255,22 @@ class RenderPass {
 	std::vector<AccessedProxyResource> _proxyInputs;
 	std::vector<AccessedProxyResource> _proxyOutputs;
 
-	std::vector<RenderBufferResource*> _storageInputs;
-	std::vector<RenderBufferResource*> _storageOutputs;
-	std::vector<RenderBufferResource*> _transferOutputs;
+	BufferList _storageInputs;
+	BufferList _storageOutputs;
+	BufferList _transferOutputs;
 
-	std::vector<RenderTextureResource*> _attachmentInputs;
-	std::vector<RenderTextureResource*> _blitTextureInputs;
-	std::vector<RenderTextureResource*> _blitTextureOutputs;
-	std::vector<RenderTextureResource*> _colorInputs;
-	std::vector<RenderTextureResource*> _colorOutputs;
-	std::vector<RenderTextureResource*> _colorScaleInputs;
+	TextureList _attachmentInputs;
+	TextureList _blitTextureInputs;
+	TextureList _blitTextureOutputs;
+	TextureList _colorInputs;
+	TextureList _colorOutputs;
+	TextureList _colorScaleInputs;
 	RenderTextureResource* _depthStencilInput  = nullptr;
 	RenderTextureResource* _depthStencilOutput = nullptr;
-	std::vector<RenderTextureResource*> _historyInputs;
-	std::vector<RenderTextureResource*> _resolveOutputs;
-	std::vector<RenderTextureResource*> _storageTextureInputs;
-	std::vector<RenderTextureResource*> _storageTextureOutputs;
+	TextureList _historyInputs;
+	TextureList _resolveOutputs;
+	TextureList _storageTextureInputs;
+	TextureList _storageTextureOutputs;
 
 	std::vector<std::pair<RenderTextureResource*, RenderTextureResource*>> _fakeResourceAliases;
 };
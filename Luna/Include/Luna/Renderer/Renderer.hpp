@@ -9,6 +9,7 @@ class Renderer final {
 	static void Shutdown();
 
 	static Vulkan::Device& GetDevice();
+	static GeometryArena& GetGeometryArena();
 	static void Render();
 };
 }  // namespace Luna
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <Luna/Core/Filesystem.hpp>
+#include <Luna/Renderer/Bvh.hpp>
 #include <Luna/Renderer/Common.hpp>
+#include <Luna/Renderer/GeometryArena.hpp>
+#include <Luna/Renderer/Texture.hpp>
+#include <Luna/Renderer/TextureStreamer.hpp>
 #include <Luna/Utility/Path.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <optional>
+#include <thread>
 
 namespace Luna {
 struct GltfContext;
+class ImportTimer;
+struct SceneImportStats;
+struct SceneLoad;
+using SceneLoadHandle = IntrusivePtr<SceneLoad>;
 
 struct Vertex {
 	glm::vec3 Normal    = glm::vec3(0.0f);
@@ -23,13 +34,23 @@ struct Vertex {
 	}
 };
 
-struct CombinedVertex {
-	glm::vec3 Position;
-	Vertex Attributes;
+/**
+ * A compact encoding of Vertex, decoded by DecodeVertex() in Common.glsli. Positions are stored separately at full
+ * precision regardless of the vertex format.
+ */
+struct QuantizedVertex {
+	uint32_t Normal;    /** Octahedral, as two signed normalized 16-bit values. */
+	uint32_t Tangent;   /** Octahedral, as Normal. The lowest bit of the second value holds the sign of Tangent.w. */
+	uint32_t Texcoord0; /** Two half-precision floats. */
+	uint32_t Texcoord1; /** Two half-precision floats. */
+	uint32_t Color0;    /** Four unsigned normalized 8-bit values. */
+	uint32_t Joints0;   /** Four unsigned 8-bit values. */
+	uint32_t Weights0;  /** Four unsigned normalized 8-bit values. */
+};
 
-	bool operator==(const CombinedVertex& other) const {
-		return Position == other.Position && Attributes == other.Attributes;
-	}
+enum class VertexFormat : uint32_t {
+	Float,    /** Attributes are stored as Vertex. */
+	Quantized /** Attributes are stored as QuantizedVertex. */
 };
 
 struct Meshlet {
@@ -38,52 +59,198 @@ struct Meshlet {
 	uint32_t TriangleOffset;
 	uint32_t IndexCount;
 	uint32_t TriangleCount;
-	uint32_t InstanceID;
 	glm::vec3 AABBMin;
 	glm::vec3 AABBMax;
+	glm::vec3 SphereCenter;
+	float SphereRadius;
+	glm::vec3 ConeApex;
+	uint32_t ConeAxisCutoff; /** Normal cone axis (xyz) and cutoff (w), as signed normalized 8-bit values. */
+	glm::vec4 LodBounds;       /** Sphere (xyz center, w radius) which LodError is measured from. */
+	float LodError;            /** Mesh-space error of the group this cluster was built from. Zero for full detail. */
+	glm::vec4 ParentLodBounds; /** Sphere which ParentLodError is measured from. */
+	float ParentLodError;      /** Error of the group this cluster was simplified into, or FLT_MAX at the DAG's root. */
 };
 
 struct Mesh {
 	std::vector<Meshlet> Meshlets;
+	uint32_t MeshletOffset = 0;     /** Position of the first of Meshlets in the GeometryArena's meshlet buffer. */
+	bool Resident          = false; /** Set once the mesh's geometry has been uploaded and it can be drawn. */
+	Bvh MeshletBvh;                 /** Over the bounds of the full-detail Meshlets, in mesh space. */
+	std::vector<uint32_t> Textures; /** glTF images sampled by the mesh's materials. */
 };
 
+/**
+ * The flattened form of a Scene which the renderer draws from, kept up to date incrementally by Scene::Update().
+ *
+ * Meshlets are stored once per mesh, in the GeometryArena's meshlet buffer. Each instance refers to its mesh's meshlets
+ * by range, and the GPU expands instances into one cull work item per meshlet. After every update, the Dirty ranges
+ * list which elements changed since the previous update, so only those need to be uploaded.
+ */
 struct RenderScene {
-	std::vector<Meshlet> Meshlets;
-	std::vector<glm::mat4> Transforms;
-	uint64_t TriangleCount = 0;
+	struct Range {
+		uint32_t Offset;
+		uint32_t Count;
+	};
+
+	struct Instance {
+		uint32_t MeshletOffset = 0; /** First meshlet of the instanced mesh, in the GeometryArena's meshlet buffer. */
+		uint32_t MeshletCount  = 0; /** Zero for unused instance IDs, and instances hidden by CPU occlusion culling. */
+		uint32_t FirstWorkItem = 0; /** Total MeshletCount of every instance before this one. */
+		uint32_t Reserved      = 0;
+	};
+
+	std::vector<Instance> Instances;
+	std::vector<glm::mat4> Transforms; /** World transform per instance. */
+	uint32_t MeshletCount      = 0;    /** Total MeshletCount of every instance. */
+	uint64_t TriangleCount     = 0;
+	uint32_t OccludedInstances = 0; /** Instances hidden or off screen in the last culled update. */
+
+	std::vector<Range> DirtyInstances;
+	std::vector<Range> DirtyTransforms;
 };
 
 class Scene {
  public:
 	struct Node {
-		[[nodiscard]] glm::mat4 GetGlobalTransform() const noexcept;
-
 		Node* Parent = nullptr;
 		std::vector<Node*> Children;
 		glm::mat4 Transform = glm::mat4(1.0f);
 
-		Mesh* Mesh = nullptr;
+		Mesh* Mesh    = nullptr;
+		bool Occluder = false; /** Rasterized for CPU occlusion culling. If no node is, occluders are picked by size. */
+
+		// Managed by the Scene. Use Scene::SetTransform() and Scene::SetMesh() to change a node after loading.
+		uint32_t Index      = std::numeric_limits<uint32_t>::max(); /** Position in the Scene's transform order. */
+		uint32_t InstanceID = std::numeric_limits<uint32_t>::max();
+		uint64_t Triangles  = 0; /** Triangles of the instanced mesh, which may since have been replaced by SetMesh(). */
+		bool MeshDirty      = false;
 	};
 
-	[[nodiscard]] Vulkan::Buffer& GetPositionBuffer() {
-		return *_positionBuffer;
-	}
-	[[nodiscard]] Vulkan::Buffer& GetVertexBuffer() {
-		return *_vertexBuffer;
+	struct RaycastHit {
+		Node* Node        = nullptr;
+		uint32_t Meshlet  = 0;    /** Index into the node's Mesh::Meshlets. */
+		uint32_t Triangle = 0;    /** Triangle within the meshlet. */
+		float Distance    = 0.0f; /** Distance along the ray, in multiples of its direction. */
+	};
+
+	~Scene() noexcept;
+
+	/**
+	 * Textures by glTF image index. Null until their mip tail is uploaded, and for images which are not KTX2. Each image
+	 * only holds the texture's resident levels, and is replaced as they change.
+	 */
+	[[nodiscard]] const std::vector<Vulkan::ImageHandle>& GetTextures() const noexcept {
+		return _textureStreamer.GetImages();
 	}
-	[[nodiscard]] Vulkan::Buffer& GetIndexBuffer() {
-		return *_indexBuffer;
+	[[nodiscard]] const TextureStreamer& GetTextureStreamer() const noexcept {
+		return _textureStreamer;
 	}
-	[[nodiscard]] Vulkan::Buffer& GetTriangleBuffer() {
-		return *_triangleBuffer;
+	[[nodiscard]] VertexFormat GetVertexFormat() const noexcept {
+		return _vertexFormat;
 	}
 
+	/** Empty the scene. If a model is still being read by LoadModel(), this waits for it and discards it. */
 	void Clear();
-	RenderScene Flatten() const;
-	void LoadModel(const Path& gltfFile);
+	/** A node's world transform, as of the last Update(). */
+	[[nodiscard]] const glm::mat4& GetGlobalTransform(const Node& node) const {
+		return _globalTransforms[node.Index];
+	}
+	/** Change a node's local transform. The change reaches the RenderScene on the next Update(). */
+	void SetTransform(Node& node, const glm::mat4& transform);
+	/** Change which mesh a node instances. The change reaches the RenderScene on the next Update(). */
+	void SetMesh(Node& node, Mesh* mesh);
+	/**
+	 * Apply every change made since the last call to the given RenderScene, and record what changed in its Dirty ranges.
+	 * The scene is rebuilt in full after a load or a clear, or when given a different RenderScene than last time.
+	 * Otherwise, only changed nodes are visited, so a static scene costs next to nothing.
+	 *
+	 * Given an OcclusionBuffer which has been begun with the current camera, the scene's occluders are rasterized into
+	 * it, and every instance whose bounds it hides is given no meshlets until it is visible again. This tests every
+	 * instance on every update.
+	 */
+	void Update(RenderScene& scene, OcclusionBuffer* occlusion = nullptr);
+	/**
+	 * Find the nearest full-detail triangle hit by the ray within maxDistance, as of the last Update().
+	 *
+	 * Each mesh has a BVH over its meshlets, and the scene has one over its instances which is refit as nodes move, so
+	 * this only visits the triangles of meshlets the ray passes through.
+	 */
+	[[nodiscard]] std::optional<RaycastHit> Raycast(const glm::vec3& origin,
+	                                                const glm::vec3& direction,
+	                                                float maxDistance = std::numeric_limits<float>::max()) const;
+	/** Append every node whose mesh's bounds are at least partly inside the frustum, as of the last Update(). */
+	void QueryFrustum(std::span<const glm::vec4, 6> planes, std::vector<Node*>& nodes) const;
+	/**
+	 * Request the texture detail needed to draw the scene from the given camera, streamed in by the next Update().
+	 *
+	 * Each instance in the frustum asks for its mesh's textures at the size its bounds cover on screen, on the assumption
+	 * that its texture coordinates span the texture once. pixelsPerUnit is the on-screen size of one unit at a distance
+	 * of one: the projection's vertical scale times half the viewport height.
+	 */
+	void RequestTextureMips(std::span<const glm::vec4, 6> planes, const glm::vec3& cameraPosition, float pixelsPerUnit);
+	/**
+	 * Replace the scene's contents with the given model.
+	 *
+	 * A .lunascene file is loaded directly. For a glTF file, a baked copy alongside it is used if one exists and is up
+	 * to date; otherwise the glTF is imported and the result is baked for the next load.
+	 *
+	 * The scene is emptied immediately and the model is read on a thread of its own, which waits while the worker
+	 * threads run the import's stages, so this returns without waiting. Once read, Update() uploads its geometry a few
+	 * megabytes per frame, and each mesh appears in the RenderScene as soon as its geometry is resident. The returned
+	 * handle reports progress. A previous model still being read is waited for first.
+	 *
+	 * The glTF's KTX2 images are transcoded on worker threads alongside the import, to the best compressed format the
+	 * device supports. Their smallest mip levels are uploaded alongside the geometry, the rest as RequestTextureMips()
+	 * asks for them. Other image formats are skipped.
+	 *
+	 * Geometry is stored in the renderer's GeometryArena, alongside that of any other Scene, in the arena's vertex
+	 * format. The load fails if the arena has no room for it, or if a .lunascene is given that was baked in another
+	 * vertex format.
+	 */
+	SceneLoadHandle LoadModel(const Path& modelFile);
+	/**
+	 * Import a glTF file the way LoadModel() does, on the calling thread and the worker threads, and wait for it. No
+	 * baked copy is read or written and nothing touches the GPU, so this runs without a device. Returns nullptr if the
+	 * import fails.
+	 *
+	 * Given stats, the time taken by each stage of the import and the size of its output are recorded in them.
+	 */
+	[[nodiscard]] static std::unique_ptr<Scene> Import(const Path& gltfFile,
+	                                                   VertexFormat format,
+	                                                   TextureTarget textureTarget,
+	                                                   SceneImportStats* stats = nullptr);
 
  private:
+	enum class GeometryStream : uint32_t { Positions, Vertices, Indices, Triangles, Meshlets, Count };
+	constexpr static size_t GeometryStreamCount = size_t(GeometryStream::Count);
+	using GeometryStreamOffsets                 = std::array<uint64_t, GeometryStreamCount>;
+
+	bool Load(const Path& modelFile, VertexFormat format);
+	void PrepareImportedStreams();
+	void PrepareStreaming();
+	void BuildMeshBvhs(ImportTimer& timer);
+	bool BeginStreaming(Scene& loaded);
+	bool StreamGeometry();
+	void StreamTextures();
+	void WriteMeshlets(Vulkan::Buffer& staging, uint64_t stagingOffset, uint64_t offset, uint64_t size) const;
+	void RelocateGeometry();
+	bool ImportGltf(const Path& gltfFile, VertexFormat format, ImportTimer& timer);
+	bool ImportGltfTextures(const Path& gltfFile);
+	bool LoadBaked(const Path& bakedFile, std::optional<uint64_t> sourceModified, VertexFormat format);
 	bool ParseGltf(GltfContext& context);
+	bool SaveBaked(const Path& bakedFile, uint64_t sourceModified) const;
+	void BuildTransformOrder();
+	void PropagateTransforms(RenderScene& scene);
+	void RebuildRenderScene(RenderScene& scene);
+	void RemoveInstance(RenderScene& scene, Node& node);
+	void AddInstance(RenderScene& scene, Node& node, const glm::mat4& globalTransform);
+	void UpdateWorkItems(RenderScene& scene);
+	void AddResidentInstances(RenderScene& scene);
+	void UpdateInstanceBvh();
+	void SelectOccluders();
+	void CullOccludedInstances(RenderScene& scene, OcclusionBuffer* occlusion);
+	const std::vector<glm::vec3>& GetOccluderTriangles(const Mesh& mesh);
+	glm::vec3 GetMeshletVertex(const Meshlet& meshlet, uint32_t triangle, uint32_t corner) const;
 
 	std::vector<Mesh> _meshes;
 	std::vector<Node> _nodes;
@@ -91,39 +258,99 @@ class Scene {
 
 	std::vector<glm::vec3> _positions;
 	std::vector<Vertex> _vertices;
+	std::vector<QuantizedVertex> _quantizedVertices;
 	std::vector<uint32_t> _indices;
 	std::vector<uint8_t> _triangles;
+	std::vector<Meshlet> _meshlets;
+	FileMappingHandle _bakedMapping;
+
+	VertexFormat _vertexFormat = VertexFormat::Float;
 
-	Vulkan::BufferHandle _positionBuffer;
-	Vulkan::BufferHandle _vertexBuffer;
-	Vulkan::BufferHandle _indexBuffer;
-	Vulkan::BufferHandle _triangleBuffer;
+	// This scene's ranges of the GeometryArena. Meshlets are rebased onto them as they are uploaded.
+	GeometryArena::Handle _geometry;
+	GeometryArena::StreamSizes _geometryOffsets = {};
+	uint32_t _geometryGeneration                = 0;
+
+	RenderScene* _renderScene = nullptr;
+	std::vector<uint32_t> _freeInstances;
+	uint32_t _firstStaleInstance = std::numeric_limits<uint32_t>::max(); /** Lowest instance whose FirstWorkItem moved. */
+	std::vector<Node*> _dirtyNodes;
+
+	// Node transforms stored by Node::Index, in parent-before-child order, so that world transforms are computed in a
+	// single linear pass with each parent's result already available.
+	std::vector<Node*> _transformNodes;
+	std::vector<uint32_t> _transformParents;
+	std::vector<glm::mat4> _localTransforms;
+	std::vector<glm::mat4> _globalTransforms;
+	std::vector<uint8_t> _transformDirty;
+	bool _anyTransformDirty = false;
+
+	// World-space bounds of every node with a mesh, by Node::Index. The BVH over them is rebuilt when nodes are added or
+	// change mesh, and refit when they only move.
+	Bvh _instanceBvh;
+	std::vector<BvhBounds> _instanceBounds;
+	std::vector<uint32_t> _changedInstanceBounds;
+	bool _instanceBvhDirty = false;
+
+	// Nodes rasterized for CPU occlusion culling, by Node::Index, and the triangles each of their meshes is drawn with.
+	std::vector<uint32_t> _occluders;
+	std::unordered_map<const Mesh*, std::vector<glm::vec3>> _occluderTriangles;
+	bool _anyOccluded = false;
+
+	// The model being loaded, and the progress of streaming its geometry to the GPU. Each stream's source is either
+	// one of the arrays above or a section of _bakedMapping, and is uploaded front to back, in mesh order.
+	SceneLoadHandle _load;
+	std::thread _loadThread;
+	std::array<std::span<const std::byte>, GeometryStreamCount> _streamSources;
+	GeometryStreamOffsets _streamCursors = {};
+	std::vector<GeometryStreamOffsets> _meshStreamEnds; /** How far each stream must be uploaded for a mesh to draw. */
+	uint32_t _residentMeshes = 0;
+
+	TextureTarget _textureTarget = TextureTarget::Uncompressed;
+	std::vector<TextureData> _textureData; /** Transcoded textures by glTF image index, until streaming begins. */
+	TextureStreamer _textureStreamer;
 };
-}  // namespace Luna
 
-template <>
-struct std::hash<Luna::Vertex> {
-	size_t operator()(const Luna::Vertex& v) {
-		Luna::Hasher h;
-		h.Data(sizeof(v.Normal), glm::value_ptr(v.Normal));
-		h.Data(sizeof(v.Tangent), glm::value_ptr(v.Tangent));
-		h.Data(sizeof(v.Texcoord0), glm::value_ptr(v.Texcoord0));
-		h.Data(sizeof(v.Texcoord1), glm::value_ptr(v.Texcoord1));
-		h.Data(sizeof(v.Color0), glm::value_ptr(v.Color0));
-		h.Data(sizeof(v.Joints0), glm::value_ptr(v.Joints0));
-		h.Data(sizeof(v.Weights0), glm::value_ptr(v.Weights0));
-
-		return static_cast<size_t>(h.Get());
-	}
+/** Progress of a Scene::LoadModel() call. Shared between the Scene, the loading thread, and the caller. */
+struct SceneLoad : public ThreadSafeIntrusivePtrEnabled<SceneLoad> {
+	enum class LoadState : uint32_t {
+		Reading,   /** The model is being read or imported on the loading thread. */
+		Uploading, /** Meshes and texture mip tails are being uploaded. Meshes appear in the scene as they complete. */
+		Complete,
+		Failed
+	};
+
+	std::atomic<LoadState> State          = LoadState::Reading;
+	std::atomic_uint32_t MeshCount        = 0;
+	std::atomic_uint32_t ResidentMeshes   = 0;
+	std::atomic_uint32_t TextureCount     = 0;
+	std::atomic_uint32_t ResidentTextures = 0;
+
+	// Written by the loading thread before State leaves Reading, then taken over by the Scene which started the load.
+	std::unique_ptr<Scene> Loaded;
 };
 
-template <>
-struct std::hash<Luna::CombinedVertex> {
-	size_t operator()(const Luna::CombinedVertex& v) const {
-		Luna::Hasher h;
-		h.Data(sizeof(v.Position), glm::value_ptr(v.Position));
-		h(v.Attributes);
+/** Where the time of a Scene::Import() went, and what it produced. */
+struct SceneImportStats {
+	struct Stage {
+		std::string Name;
+		double WallTime    = 0.0; /** Seconds from the stage's first task starting to its last task finishing. */
+		double BusyTime    = 0.0; /** Seconds spent running the stage's tasks, summed over every thread. */
+		uint32_t TaskCount = 0;
+	};
+
+	std::vector<Stage> Stages; /** In the order they start. Textures load alongside the mesh stages. */
+	double WallTime      = 0.0;
+	uint32_t ThreadCount = 0; /** Worker threads available to the import's tasks. */
 
-		return static_cast<size_t>(h.Get());
-	}
+	uint32_t MeshCount     = 0;
+	uint32_t NodeCount     = 0;
+	uint32_t MeshletCount  = 0; /** Meshlets of every level of detail. */
+	uint64_t VertexCount   = 0;
+	uint64_t IndexCount    = 0; /** Entries of the meshlets' vertex index lists. */
+	uint64_t TriangleCount = 0; /** Triangles of the full-detail meshlets. */
+	uint32_t TextureCount  = 0; /** Images which were read and transcoded. */
+	uint64_t TextureBytes  = 0;
 };
+}  // namespace Luna
+
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Luna/Renderer/Common.hpp>
+#include <Luna/Utility/Path.hpp>
+#include <Luna/Vulkan/Image.hpp>
+#include <optional>
+
+namespace Luna {
+/** The family of formats which Basis Universal textures are transcoded to, chosen by what the device can sample. */
+enum class TextureTarget {
+	BC,          /** BC7 for color, BC5 for two-channel and BC4 for single-channel textures. */
+	ASTC,        /** ASTC 4x4. */
+	Uncompressed /** RGBA8, for devices which sample neither. */
+};
+
+struct TextureMip {
+	uint32_t Width  = 0;
+	uint32_t Height = 0;
+	size_t Offset   = 0; /** Position of the level's first byte in TextureData::Data. */
+	size_t Size     = 0;
+};
+
+/** A 2D texture in a format the GPU samples directly, ready to upload. */
+struct TextureData {
+	vk::Format Format = vk::Format::eUndefined;
+	std::vector<TextureMip> Mips; /** Largest first. */
+	std::vector<uint8_t> Data;
+
+	[[nodiscard]] bool Empty() const noexcept {
+		return Mips.empty();
+	}
+};
+
+/** The best target the device can sample: BC, then ASTC, then uncompressed. */
+[[nodiscard]] TextureTarget GetTextureTarget(const Vulkan::Device& device);
+/**
+ * Read a KTX2 texture. Basis Universal textures are transcoded to the target's format, textures stored in any other
+ * format are returned as they are.
+ *
+ * Each call is independent of every other, so textures are meant to be loaded side by side on worker threads.
+ */
+[[nodiscard]] std::optional<TextureData> LoadKtx2(std::span<const uint8_t> file,
+                                                  TextureTarget target,
+                                                  std::string_view name);
+[[nodiscard]] std::optional<TextureData> LoadKtx2(const Path& path, TextureTarget target);
+/** Create a sampled image holding the texture's mip levels from firstMip down, with firstMip as its base level. */
+[[nodiscard]] Vulkan::ImageHandle CreateTextureImage(Vulkan::Device& device,
+                                                     const TextureData& texture,
+                                                     uint32_t firstMip            = 0,
+                                                     const std::string& debugName = "");
+}  // namespace Luna
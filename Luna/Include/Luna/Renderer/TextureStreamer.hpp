@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Luna/Renderer/Texture.hpp>
+
+namespace Luna {
+/**
+ * Keeps a set of textures on the GPU at the detail they are seen at, within the device's memory budget.
+ *
+ * Every texture starts with only its mip tail: the levels no larger than TailSize, which are cheap enough to upload for
+ * every texture up front. Each frame, callers request the finest level each texture needs, and Update() raises textures
+ * towards their requests one level at a time, those furthest from theirs first. Textures may use whatever part of the
+ * budget reported by VMA the rest of the process leaves free. When that runs out, levels are evicted from textures
+ * which hold more detail than they were asked for, and requests which still do not fit wait until room is made.
+ *
+ * A texture's image only ever holds its resident levels, so changing its residency replaces the image. Replaced images
+ * count against the budget until the frames in flight which may use them complete. The full mip chain of every texture
+ * is kept in CPU memory, to upload from.
+ */
+class TextureStreamer {
+ public:
+	/** Levels no larger than this in either dimension are uploaded first, and never evicted. */
+	constexpr static uint32_t TailSize = 64;
+	/** Fraction of the device-local budget which may be allocated in total, leaving headroom for other processes. */
+	constexpr static double BudgetFraction = 0.9;
+
+	/** Replace every texture. The new textures have nothing resident until the next Update(). */
+	void Reset(std::vector<TextureData> textures);
+
+	[[nodiscard]] uint32_t GetTextureCount() const noexcept {
+		return uint32_t(_textures.size());
+	}
+	/** Textures which can be sampled, because at least their mip tail is resident. Empty textures are counted. */
+	[[nodiscard]] uint32_t GetResidentTextureCount() const noexcept {
+		return _residentTextures;
+	}
+	/** Images by texture index. Null until the texture's mip tail is uploaded, and for empty textures. */
+	[[nodiscard]] const std::vector<Vulkan::ImageHandle>& GetImages() const noexcept {
+		return _images;
+	}
+	/** The level of the full mip chain which the texture's image starts at. */
+	[[nodiscard]] uint32_t GetResidentMip(uint32_t texture) const {
+		return _textures[texture].ResidentMip;
+	}
+	/** Bytes of the current images. Replaced images are not counted, though they take up memory until released. */
+	[[nodiscard]] uint64_t GetResidentBytes() const noexcept {
+		return _residentBytes;
+	}
+	/** Bytes textures may occupy, as of the last Update(). */
+	[[nodiscard]] uint64_t GetBudgetBytes() const noexcept {
+		return _budgetBytes;
+	}
+
+	/** Ask for a texture to be resident from the given level down. Of several requests in one frame, the finest wins. */
+	void RequestMip(uint32_t texture, uint32_t mip);
+	/** Request the smallest level which is at least the given size on screen, so the texture is sampled without blur. */
+	void RequestSize(uint32_t texture, float pixels);
+	/**
+	 * Upload the mip tails of new textures, then act on this frame's requests, staging no more than uploadBudget bytes.
+	 * Requests are cleared afterwards, so a texture which is not requested again becomes free to evict.
+	 */
+	void Update(Vulkan::Device& device, uint64_t uploadBudget);
+
+ private:
+	struct StreamedTexture {
+		TextureData Data;
+		uint32_t TailMip       = 0; /** First level of the mip tail. */
+		uint32_t ResidentMip   = 0; /** First resident level, or the level count while nothing is resident. */
+		uint32_t RequestedMip  = 0; /** Finest level requested this frame, or TailMip. */
+		uint64_t ResidentBytes = 0;
+	};
+
+	/** Total size of the texture's levels from firstMip down. */
+	[[nodiscard]] static uint64_t GetLevelBytes(const StreamedTexture& texture, uint32_t firstMip);
+	/** Replace the texture's image with one holding its levels from firstMip down. Returns the bytes uploaded. */
+	uint64_t SetResidentMip(Vulkan::Device& device, uint32_t texture, uint32_t firstMip);
+	/**
+	 * Evict levels until the given number of bytes fits within the budget, starting with the textures which hold the
+	 * most detail beyond their requests. Textures which hold no more than they requested are only evicted if force is
+	 * set, largest first. Evicting uploads the smaller images, so it stops once uploaded reaches uploadBudget. Returns
+	 * whether the bytes fit.
+	 */
+	bool MakeRoom(Vulkan::Device& device, uint64_t bytes, bool force, uint64_t uploadBudget, uint64_t& uploaded);
+
+	std::vector<StreamedTexture> _textures;
+	std::vector<Vulkan::ImageHandle> _images;
+	uint32_t _residentTextures = 0; /** Textures before this index have their mip tail resident. */
+	uint64_t _residentBytes    = 0;
+	uint64_t _budgetBytes      = 0;
+	/** Bytes of replaced images, by the frame context they were released in. They are destroyed when it is reused. */
+	std::vector<uint64_t> _retiringByFrame;
+	uint64_t _retiringBytes   = 0; /** Total of _retiringByFrame and _unassignedBytes. */
+	uint64_t _unassignedBytes = 0; /** Released by Reset(), outside of Update(), in a frame context not yet known. */
+};
+}  // namespace Luna
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Luna/Common.hpp>
+#include <Luna/Utility/SmallVector.hpp>
 
 namespace Luna {
 template <typename>
@@ -8,123 +9,83 @@ class Delegate;
 template <typename...>
 class CancellableDelegate;
 
-// A simple class that contains a shared pointer. This is used to track object lifetimes in delegate callbacks. If the
-// object that extends Observer is destroyed, the shared pointer will be destroyed as well, invalidating all of the weak
-// references stored in the delegate callback. This can be used to ensure any delegate callbacks that rely on an
-// object's lifetime are removed when the object is destroyed.
-class Observer {
- public:
-	Observer() : ObserverIsAlive(std::make_shared<bool>(true)) {}
-	virtual ~Observer() noexcept = default;
-
-	std::shared_ptr<bool> ObserverIsAlive;
-};
-
-template <typename T>
-concept IsObserver = std::is_convertible_v<typename std::remove_reference<T>::type*, Observer*>;
-
-// Template class used to invoke delegates that return some type of value. The invoker will look for any delegate
-// callbacks that have expired observers and remove them from the delegate.
-template <typename ReturnT, typename... Args>
-class Invoker {
- public:
-	using ReturnValuesT = std::vector<ReturnT>;
-
-	static ReturnValuesT Invoke(Delegate<ReturnT(Args...)>& delegate, Args&&... args) {
-		std::lock_guard<std::mutex> lock(delegate._mutex);
-
-		ReturnValuesT values;
-		for (auto it = delegate._functions.begin(); it != delegate._functions.end();) {
-			if (it->IsExpired()) {
-				it = delegate._functions.erase(it);
-				continue;
-			}
-
-			values.emplace_back((*it->Function)(std::forward<Args>(args)...));
-			++it;
-		}
-
-		return values;
+// Shared liveness token for an Observer. The token outlives the Observer for as long as any delegate callback still
+// references it, and is flagged as dead when the Observer is destroyed. Checking for expiry is a single atomic load.
+struct ObserverState : public ThreadSafeIntrusivePtrEnabled<ObserverState> {
+	ObserverState() noexcept {
+		Alive.store(true, std::memory_order_relaxed);
 	}
-};
-
-// Template class used to invoke delegates that have no return value. The invoker will look for any delegate callbacks
-// that have expired and remove them from the delegate.
-template <typename... Args>
-class Invoker<void, Args...> {
- public:
-	using ReturnValuesT = void;
 
-	static void Invoke(Delegate<void(Args...)>& delegate, Args&&... args) {
-		std::lock_guard<std::mutex> lock(delegate._mutex);
-
-		if (delegate._functions.empty()) { return; }
-
-		for (auto it = delegate._functions.begin(); it != delegate._functions.end();) {
-			if (it->IsExpired()) {
-				it = delegate._functions.erase(it);
-				continue;
-			}
-
-			it->Function(std::forward<Args>(args)...);
-			++it;
-		}
+	[[nodiscard]] bool IsAlive() const noexcept {
+		return Alive.load(std::memory_order_acquire);
 	}
+
+	std::atomic_bool Alive;
 };
+using ObserverStateHandle = IntrusivePtr<ObserverState>;
 
-// Template class used to invoke delegates that can be cancelled. All delegate functions must return a bool, and if any
-// delegate function returns true, the remaining delegate functions will not be evaluated.
-template <typename... Args>
-class CancellableInvoker {
+// A simple class that contains a liveness token. This is used to track object lifetimes in delegate callbacks. If the
+// object that extends Observer is destroyed, the token is marked as dead, which expires all of the delegate callbacks
+// registered with it. This can be used to ensure any delegate callbacks that rely on an object's lifetime are removed
+// when the object is destroyed.
+class Observer {
  public:
-	using ReturnValuesT = void;
-
-	static void Invoke(CancellableDelegate<Args...>& delegate, Args&&... args) {
-		std::lock_guard<std::mutex> lock(delegate._mutex);
-
-		if (delegate._functions.empty()) { return; }
-
-		for (auto it = delegate._functions.begin(); it != delegate._functions.end();) {
-			if (it->IsExpired()) {
-				it = delegate._functions.erase(it);
-				continue;
-			}
+	Observer() : ObserverIsAlive(MakeHandle<ObserverState>()) {}
+	Observer(const Observer&) : Observer() {}
+	Observer& operator=(const Observer&) noexcept {
+		return *this;
+	}
+	virtual ~Observer() noexcept {
+		ObserverIsAlive->Alive.store(false, std::memory_order_release);
+	}
 
-			if (it->Function(std::forward<Args>(args)...)) { break; }
+	ObserverStateHandle ObserverIsAlive;
+};
 
-			++it;
-		}
-	}
+template <typename T>
+concept IsObserver = requires(const T& observer) {
+	{ std::to_address(observer) } -> std::convertible_to<Observer*>;
 };
 
-// Delegate object class. This object holds a dynamic number of callbacks that can be invoked using operator() on the
-// Delegate object. Callbacks can be added and removed at will during runtime, and all valid callbacks at the time of
-// invocation will be called.
+// Storage shared by all delegate types. Callbacks are held in an immutable list which is swapped out atomically
+// whenever a callback is added or removed, so invoking a delegate never takes a lock or allocates.
+//
+// Writers serialize on a mutex, build a new list and publish it. The previous list is retired, and only freed once no
+// invocation is in flight, which is tracked by a simple reader counter.
 template <typename ReturnT, typename... Args>
-class Delegate<ReturnT(Args...)> {
+class DelegateBase {
  public:
 	using FunctionT  = std::function<ReturnT(Args...)>;
-	using InvokerT   = Invoker<ReturnT, Args...>;
-	using ObserversT = std::vector<std::weak_ptr<bool>>;
+	using ObserversT = std::vector<ObserverStateHandle>;
 
 	// A FunctionPair represents a single "callback" registered to this Delegate. It includes a function to call, and a
 	// list of "observers". Observers can be any class that extends the Observer class. At the time of registering a
 	// callback, one may optionally include a list of observers. If any observers have been destroyed before the callback
-	// is called, the callback will automatically be removed.
+	// is called, the callback will be skipped and eventually removed.
 	struct FunctionPair {
 		FunctionT Function;
 		ObserversT Observers;
 
-		bool IsExpired() const {
+		bool IsExpired() const noexcept {
 			for (const auto& observer : Observers) {
-				if (observer.expired()) { return true; }
+				if (!observer->IsAlive()) { return true; }
 			}
 
 			return false;
 		}
 	};
 
-	Delegate() = default;
+	struct ListenerList {
+		std::vector<FunctionPair> Functions;
+	};
+
+	DelegateBase() = default;
+	DelegateBase(const DelegateBase&)            = delete;
+	DelegateBase& operator=(const DelegateBase&) = delete;
+	~DelegateBase() noexcept {
+		delete _listeners.load(std::memory_order_acquire);
+		for (auto* list : _retired) { delete list; }
+	}
 
 	template <IsObserver... ObserverList>
 	void Add(FunctionT&& function, ObserverList... observers) {
@@ -132,52 +93,67 @@ class Delegate<ReturnT(Args...)> {
 		if constexpr (sizeof...(observers) != 0) {
 			observerList.reserve(sizeof...(observers));
 			for (const auto& observer : {observers...}) {
-				observerList.emplace_back(static_cast<Observer*>(std::to_address(observer))->ObserverIsAlive);
+				observerList.push_back(static_cast<Observer*>(std::to_address(observer))->ObserverIsAlive);
 			}
 		}
 
 		std::lock_guard<std::mutex> lock(_mutex);
-		_functions.emplace_back(FunctionPair{std::move(function), std::move(observerList)});
+		auto functions = CopyFunctions();
+		functions.push_back(FunctionPair{std::move(function), std::move(observerList)});
+		Publish(std::move(functions));
 	}
 
 	void Clear() {
 		std::lock_guard<std::mutex> lock(_mutex);
-		_functions.clear();
+		Publish({});
 	}
 
-	typename InvokerT::ReturnValuesT Invoke(Args... args) {
-		return InvokerT::Invoke(*this, std::forward<Args>(args)...);
+	[[nodiscard]] bool Empty() const noexcept {
+		const auto* list = _listeners.load(std::memory_order_acquire);
+
+		return list == nullptr || list->Functions.empty();
 	}
 
-	void MoveFunctions(Delegate<ReturnT(Args...)>& from, const ObserversT& exclude = {}) {
-		std::lock_guard<std::mutex> lock(_mutex);
-		std::lock_guard<std::mutex> lock2(from._mutex);
-		for (auto it = from._functions.begin(); it != from._functions.end();) {
-			bool move = true;
-			for (const auto& excluded : exclude) {
-				auto excludePtr = excluded.lock();
-				for (const auto& observer : it->Observers) {
-					auto observerPtr = observer.lock();
-					if (observerPtr.get() == excludePtr.get()) { move = false; }
+	void MoveFunctions(DelegateBase& from, const ObserversT& exclude = {}) {
+		if (&from == this) { return; }
+
+		std::scoped_lock lock(_mutex, from._mutex);
+		auto functions = CopyFunctions();
+		std::vector<FunctionPair> remaining;
+		if (const auto* list = from._listeners.load(std::memory_order_acquire)) {
+			for (const auto& pair : list->Functions) {
+				bool move = true;
+				for (const auto& excluded : exclude) {
+					for (const auto& observer : pair.Observers) {
+						if (observer == excluded) { move = false; }
+					}
 				}
-			}
 
-			if (move) {
-				std::move(from._functions.begin(), it, std::back_inserter(_functions));
-				it = from._functions.erase(from._functions.begin(), it);
-			} else {
-				++it;
+				if (move) {
+					functions.push_back(pair);
+				} else {
+					remaining.push_back(pair);
+				}
 			}
 		}
+		Publish(std::move(functions));
+		from.Publish(std::move(remaining));
 	}
 
-	void Remove(const FunctionT&& function) {
+	// Remove any callbacks whose observers have been destroyed.
+	void PruneExpired() {
 		std::lock_guard<std::mutex> lock(_mutex);
+		PruneExpiredNoLock();
+	}
 
-		_functions.erase(std::remove_if(_functions.begin(),
-		                                _functions.end(),
-		                                [&function](const FunctionPair& f) { return Hash(f.Function) == Hash(function); }),
-		                 _functions.end());
+	void Remove(const FunctionT&& function) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto functions = CopyFunctions();
+		functions.erase(std::remove_if(functions.begin(),
+		                               functions.end(),
+		                               [&function](const FunctionPair& f) { return Hash(f.Function) == Hash(function); }),
+		                functions.end());
+		Publish(std::move(functions));
 	}
 
 	template <IsObserver... ObserverList>
@@ -186,194 +162,239 @@ class Delegate<ReturnT(Args...)> {
 		if constexpr (sizeof...(observers) != 0) {
 			observerList.reserve(sizeof...(observers));
 			for (const auto& observer : {observers...}) {
-				observerList.emplace_back(static_cast<Observer*>(std::to_address(observer))->ObserverIsAlive);
+				observerList.push_back(static_cast<Observer*>(std::to_address(observer))->ObserverIsAlive);
 			}
 		}
 
 		std::lock_guard<std::mutex> lock(_mutex);
-		for (auto functionIt = _functions.begin(); functionIt != _functions.end();) {
-			for (auto observerIt = functionIt->Observers.begin(); observerIt != functionIt->Observers.end();) {
-				bool erase       = false;
-				auto observerPtr = observerIt->lock();
-				for (const auto& remove : observerList) {
-					auto erasePtr = remove.lock();
-					if (observerPtr.get() == erasePtr.get()) { erase = true; }
-				}
-
-				if (erase) {
-					observerIt = functionIt->Observers.erase(observerIt);
-				} else {
-					++observerIt;
-				}
-			}
+		auto functions = CopyFunctions();
+		for (auto& pair : functions) {
+			std::erase_if(pair.Observers, [&observerList](const ObserverStateHandle& observer) {
+				return std::find(observerList.begin(), observerList.end(), observer) != observerList.end();
+			});
 		}
+		Publish(std::move(functions));
 	}
 
-	Delegate<ReturnT(Args...)>& operator+=(FunctionT&& function) {
-		Add(std::move(function));
+ protected:
+	// RAII guard which pins the current listener list for the duration of an invocation.
+	class ReadGuard {
+	 public:
+		explicit ReadGuard(const DelegateBase& delegate) noexcept : _delegate(delegate) {
+			_delegate._readers.fetch_add(1, std::memory_order_seq_cst);
+			_list = _delegate._listeners.load(std::memory_order_seq_cst);
+		}
+		~ReadGuard() noexcept {
+			_delegate._readers.fetch_sub(1, std::memory_order_release);
+		}
 
-		return *this;
-	}
+		[[nodiscard]] const ListenerList* Get() const noexcept {
+			return _list;
+		}
 
-	Delegate<ReturnT(Args...)>& operator-=(FunctionT&& function) {
-		Remove(std::move(function));
+	 private:
+		const DelegateBase& _delegate;
+		const ListenerList* _list = nullptr;
+	};
 
-		return *this;
+	// Called by invokers when they skip an expired callback. Cleanup is opportunistic; if another thread is currently
+	// modifying the delegate, it will be done on a later invocation instead.
+	void OnExpiredFound() {
+		std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+		if (lock.owns_lock()) { PruneExpiredNoLock(); }
 	}
 
-	typename InvokerT::ReturnValuesT operator()(Args... args) {
-		return InvokerT::Invoke(*this, std::forward<Args>(args)...);
+ private:
+	static size_t Hash(const FunctionT& function) {
+		return function.target_type().hash_code();
 	}
 
- private:
-	friend InvokerT;
+	std::vector<FunctionPair> CopyFunctions() const {
+		const auto* list = _listeners.load(std::memory_order_acquire);
 
-	static constexpr size_t Hash(const FunctionT& function) {
-		return function.target_type().hash_code();
+		return list ? list->Functions : std::vector<FunctionPair>{};
+	}
+
+	void PruneExpiredNoLock() {
+		auto functions = CopyFunctions();
+		const auto removed = std::erase_if(functions, [](const FunctionPair& pair) { return pair.IsExpired(); });
+		if (removed > 0) { Publish(std::move(functions)); }
+	}
+
+	// Must be called with _mutex held.
+	void Publish(std::vector<FunctionPair>&& functions) {
+		const ListenerList* newList = functions.empty() ? nullptr : new ListenerList{std::move(functions)};
+		const ListenerList* oldList = _listeners.exchange(newList, std::memory_order_seq_cst);
+		if (oldList) { _retired.push_back(oldList); }
+
+		// Any reader that started after the exchange will see the new list, so once the reader count drops to zero, all
+		// retired lists are unreachable.
+		if (_readers.load(std::memory_order_seq_cst) == 0) {
+			for (auto* list : _retired) { delete list; }
+			_retired.clear();
+		}
 	}
 
-	std::vector<FunctionPair> _functions;
+	std::atomic<const ListenerList*> _listeners = nullptr;
+	mutable std::atomic_uint32_t _readers       = 0;
+	std::vector<const ListenerList*> _retired;
 	std::mutex _mutex;
 };
 
-// Specialized Delegate type that can be "cancelled". All delegate functions must return a bool. When invoking the
-// delegate, callbacks are invoked in the order which they were registered. However, if any callback returns true,
-// execution stops and subsequent callbacks will not be invoked.
-template <typename... Args>
-class CancellableDelegate {
+// Template class used to invoke delegates that return some type of value. Callbacks whose observers have expired are
+// skipped and scheduled for removal from the delegate. Most delegates have only a few listeners, so results are kept
+// inline to avoid a heap allocation per invocation.
+template <typename ReturnT, typename... Args>
+class Invoker {
  public:
-	using ReturnT    = bool;
-	using FunctionT  = std::function<ReturnT(Args...)>;
-	using InvokerT   = CancellableInvoker<ReturnT, Args...>;
-	using ObserversT = std::vector<std::weak_ptr<bool>>;
+	using ReturnValuesT = SmallVector<ReturnT, 4>;
 
-	// A FunctionPair represents a single "callback" registered to this Delegate. It includes a function to call, and a
-	// list of "observers". Observers can be any class that extends the Observer class. At the time of registering a
-	// callback, one may optionally include a list of observers. If any observers have been destroyed before the callback
-	// is called, the callback will automatically be removed.
-	struct FunctionPair {
-		FunctionT Function;
-		ObserversT Observers;
-
-		bool IsExpired() const {
-			for (const auto& observer : Observers) {
-				if (observer.expired()) { return true; }
-			}
+	template <typename DelegateT>
+	static ReturnValuesT Invoke(DelegateT& delegate, Args&... args) {
+		typename DelegateT::ReadGuard guard(delegate);
+		const auto* list = guard.Get();
 
-			return false;
-		}
-	};
-
-	CancellableDelegate() = default;
+		ReturnValuesT values;
+		if (!list) { return values; }
 
-	template <IsObserver... ObserverList>
-	void Add(FunctionT&& function, ObserverList... observers) {
-		ObserversT observerList;
-		if constexpr (sizeof...(observers) != 0) {
-			observerList.reserve(sizeof...(observers));
-			for (const auto& observer : {observers...}) {
-				observerList.emplace_back(static_cast<Observer*>(std::to_address(observer))->ObserverIsAlive);
+		bool expired = false;
+		values.reserve(list->Functions.size());
+		for (const auto& pair : list->Functions) {
+			if (pair.IsExpired()) {
+				expired = true;
+				continue;
 			}
+
+			values.emplace_back(pair.Function(args...));
 		}
+		if (expired) { delegate.OnExpiredFound(); }
 
-		std::lock_guard<std::mutex> lock(_mutex);
-		_functions.emplace_back(FunctionPair{std::move(function), std::move(observerList)});
+		return values;
 	}
+};
 
-	void Clear() {
-		std::lock_guard<std::mutex> lock(_mutex);
-		_functions.clear();
-	}
+// Template class used to invoke delegates that have no return value. No results are collected, so invoking does not
+// allocate.
+template <typename... Args>
+class Invoker<void, Args...> {
+ public:
+	using ReturnValuesT = void;
 
-	typename InvokerT::ReturnValuesT Invoke(Args&&... args) {
-		return InvokerT::Invoke(*this, std::forward<Args>(args)...);
-	}
+	template <typename DelegateT>
+	static void Invoke(DelegateT& delegate, Args&... args) {
+		typename DelegateT::ReadGuard guard(delegate);
+		const auto* list = guard.Get();
+		if (!list) { return; }
 
-	void MoveFunctions(Delegate<ReturnT(Args...)>& from, const ObserversT& exclude = {}) {
-		std::lock_guard<std::mutex> lock(_mutex);
-		std::lock_guard<std::mutex> lock2(from._mutex);
-		for (auto it = from._functions.begin(); it != from._functions.end();) {
-			bool move = true;
-			for (const auto& excluded : exclude) {
-				auto excludePtr = excluded.lock();
-				for (const auto& observer : it->Observers) {
-					auto observerPtr = observer.lock();
-					if (observerPtr.get() == excludePtr.get()) { move = false; }
-				}
+		bool expired = false;
+		for (const auto& pair : list->Functions) {
+			if (pair.IsExpired()) {
+				expired = true;
+				continue;
 			}
 
-			if (move) {
-				std::move(from._functions.begin(), it, std::back_inserter(_functions));
-				it = from._functions.erase(from._functions.begin(), it);
-			} else {
-				++it;
-			}
+			pair.Function(args...);
 		}
+		if (expired) { delegate.OnExpiredFound(); }
 	}
+};
 
-	void Remove(const FunctionT&& function) {
-		std::lock_guard<std::mutex> lock(_mutex);
+// Template class used to invoke delegates that can be cancelled. All delegate functions must return a bool, and if any
+// delegate function returns true, the remaining delegate functions will not be evaluated.
+template <typename... Args>
+class CancellableInvoker {
+ public:
+	using ReturnValuesT = void;
 
-		_functions.erase(std::remove_if(_functions.begin(),
-		                                _functions.end(),
-		                                [&function](const FunctionPair& f) { return Hash(f.Function) == Hash(function); }),
-		                 _functions.end());
-	}
+	template <typename DelegateT>
+	static void Invoke(DelegateT& delegate, Args&... args) {
+		typename DelegateT::ReadGuard guard(delegate);
+		const auto* list = guard.Get();
+		if (!list) { return; }
 
-	template <IsObserver... ObserverList>
-	void RemoveObservers(ObserverList... observers) {
-		ObserversT observerList;
-		if constexpr (sizeof...(observers) != 0) {
-			observerList.reserve(sizeof...(observers));
-			for (const auto& observer : {observers...}) {
-				observerList.emplace_back(static_cast<Observer*>(std::to_address(observer))->ObserverIsAlive);
+		bool expired = false;
+		for (const auto& pair : list->Functions) {
+			if (pair.IsExpired()) {
+				expired = true;
+				continue;
 			}
+
+			if (pair.Function(args...)) { break; }
 		}
+		if (expired) { delegate.OnExpiredFound(); }
+	}
+};
 
-		std::lock_guard<std::mutex> lock(_mutex);
-		for (auto functionIt = _functions.begin(); functionIt != _functions.end();) {
-			for (auto observerIt = functionIt->Observers.begin(); observerIt != functionIt->Observers.end();) {
-				bool erase       = false;
-				auto observerPtr = observerIt->lock();
-				for (const auto& remove : observerList) {
-					auto erasePtr = remove.lock();
-					if (observerPtr.get() == erasePtr.get()) { erase = true; }
-				}
+// Delegate object class. This object holds a dynamic number of callbacks that can be invoked using operator() on the
+// Delegate object. Callbacks can be added and removed at will during runtime, and all valid callbacks at the time of
+// invocation will be called.
+template <typename ReturnT, typename... Args>
+class Delegate<ReturnT(Args...)> : public DelegateBase<ReturnT, Args...> {
+ public:
+	using BaseT     = DelegateBase<ReturnT, Args...>;
+	using FunctionT = typename BaseT::FunctionT;
+	using InvokerT  = Invoker<ReturnT, Args...>;
 
-				if (erase) {
-					observerIt = functionIt->Observers.erase(observerIt);
-				} else {
-					++observerIt;
-				}
-			}
-		}
+	Delegate() = default;
+
+	typename InvokerT::ReturnValuesT Invoke(Args... args) {
+		return InvokerT::Invoke(*this, args...);
 	}
 
 	Delegate<ReturnT(Args...)>& operator+=(FunctionT&& function) {
-		Add(std::move(function));
+		this->Add(std::move(function));
 
 		return *this;
 	}
 
 	Delegate<ReturnT(Args...)>& operator-=(FunctionT&& function) {
-		Remove(std::move(function));
+		this->Remove(std::move(function));
 
 		return *this;
 	}
 
-	typename InvokerT::ReturnValuesT operator()(Args&&... args) {
-		return InvokerT::Invoke(*this, std::forward<Args>(args)...);
+	typename InvokerT::ReturnValuesT operator()(Args... args) {
+		return InvokerT::Invoke(*this, args...);
 	}
 
  private:
 	friend InvokerT;
+};
 
-	static constexpr size_t Hash(const FunctionT& function) {
-		return function.target_type().hash_code();
+// Specialized Delegate type that can be "cancelled". All delegate functions must return a bool. When invoking the
+// delegate, callbacks are invoked in the order which they were registered. However, if any callback returns true,
+// execution stops and subsequent callbacks will not be invoked.
+template <typename... Args>
+class CancellableDelegate : public DelegateBase<bool, Args...> {
+ public:
+	using BaseT     = DelegateBase<bool, Args...>;
+	using FunctionT = typename BaseT::FunctionT;
+	using InvokerT  = CancellableInvoker<Args...>;
+
+	CancellableDelegate() = default;
+
+	void Invoke(Args... args) {
+		InvokerT::Invoke(*this, args...);
 	}
 
-	std::vector<FunctionPair> _functions;
-	std::mutex _mutex;
+	CancellableDelegate<Args...>& operator+=(FunctionT&& function) {
+		this->Add(std::move(function));
+
+		return *this;
+	}
+
+	CancellableDelegate<Args...>& operator-=(FunctionT&& function) {
+		this->Remove(std::move(function));
+
+		return *this;
+	}
+
+	void operator()(Args... args) {
+		InvokerT::Invoke(*this, args...);
+	}
+
+ private:
+	friend InvokerT;
 };
 
 // Delegate values can have callbacks added just like normal delegates, but instead of being invoked on demand, they are
@@ -390,13 +411,13 @@ class DelegateValue : public Delegate<void(T&)> {
 
 	DelegateValue& operator=(const T& value) {
 		_value = value;
-		Invoke(_value);
+		this->Invoke(_value);
 
 		return *this;
 	}
 	DelegateValue& operator=(T&& value) {
 		_value = std::move(value);
-		Invoke(_value);
+		this->Invoke(_value);
 
 		return *this;
 	}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Luna/Utility/Hash.hpp>
+#include <Luna/Utility/Path.hpp>
+
+namespace Luna {
+struct InternedPathEntry;
+
+/**
+ * An immutable, normalized path stored in a global intern table.
+ *
+ * Each unique normalized path string exists exactly once for the lifetime of the program. Normalization, hashing, and
+ * locating the protocol, filename, and extension all happen once when a path is first interned, so equality is a
+ * pointer comparison and hashing returns the stored value. Intended as a drop-in key for hot lookups that would
+ * otherwise rehash and re-split a Path every time.
+ */
+class InternedPath {
+ public:
+	InternedPath();
+	InternedPath(const char* pathStr);
+	InternedPath(const std::string& pathStr);
+	InternedPath(std::string_view pathStr);
+	InternedPath(const Path& path);
+
+	[[nodiscard]] bool Empty() const noexcept;
+	[[nodiscard]] Hash GetHash() const noexcept;
+	[[nodiscard]] const std::string& String() const noexcept;
+	[[nodiscard]] Path ToPath() const;
+
+	[[nodiscard]] std::string_view Extension() const noexcept;
+	[[nodiscard]] std::string_view Filename() const noexcept;
+	[[nodiscard]] std::string_view FilePath() const noexcept;
+	[[nodiscard]] std::string_view ParentPath() const noexcept;
+	[[nodiscard]] std::string_view Protocol() const noexcept;
+	[[nodiscard]] std::string_view Stem() const noexcept;
+
+	[[nodiscard]] bool operator==(const InternedPath& other) const noexcept {
+		return _entry == other._entry;
+	}
+	[[nodiscard]] bool operator!=(const InternedPath& other) const noexcept {
+		return _entry != other._entry;
+	}
+
+ private:
+	const InternedPathEntry* _entry;
+};
+}  // namespace Luna
+
+namespace std {
+template <>
+struct hash<Luna::InternedPath> {
+	size_t operator()(const Luna::InternedPath& path) const noexcept {
+		return static_cast<size_t>(path.GetHash());
+	}
+};
+}  // namespace std
+
+template <>
+struct std::formatter<Luna::InternedPath> : std::formatter<std::string> {
+	auto format(const Luna::InternedPath& path, format_context& ctx) const -> decltype(ctx.out()) {
+		return format_to(ctx.out(), "{}", path.String());
+	}
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Luna/Common.hpp>
+
+namespace Luna {
+/**
+ * A two-level segregated fit (TLSF) allocator for ranges of an external resource, such as a GPU buffer.
+ *
+ * The allocator only hands out offsets into a range of Size units, and never touches the memory behind them. Free
+ * ranges are binned by size on a floating-point scale with 8 bins per power of two. A pair of bitmasks locates the
+ * smallest non-empty bin which is guaranteed to fit a request, so Allocate() and Free() run in constant time. Freed
+ * ranges merge with their free neighbours immediately.
+ *
+ * Every allocation, and every free range between allocations, uses one node. Allocate() fails once MaxNodes are in use.
+ */
+class OffsetAllocator {
+ public:
+	constexpr static uint32_t InvalidOffset = std::numeric_limits<uint32_t>::max();
+
+	struct Allocation {
+		uint32_t Offset = InvalidOffset;
+		uint32_t Node   = InvalidOffset; /** Internal. Identifies the allocation to Free(). */
+
+		[[nodiscard]] explicit operator bool() const noexcept {
+			return Offset != InvalidOffset;
+		}
+	};
+
+	struct StorageReport {
+		uint32_t TotalFree;   /** Units not covered by any allocation. */
+		uint32_t LargestFree; /** A lower bound for the largest allocation which would currently succeed. */
+	};
+
+	explicit OffsetAllocator(uint32_t size, uint32_t maxNodes = 128 * 1024);
+
+	[[nodiscard]] uint32_t GetSize() const noexcept {
+		return _size;
+	}
+
+	/** Allocate the given number of units. Returns an invalid allocation if size is zero or no free range fits. */
+	[[nodiscard]] Allocation Allocate(uint32_t size);
+	void Free(Allocation allocation);
+	/** Free every allocation at once. */
+	void Reset();
+
+	[[nodiscard]] uint32_t GetAllocationSize(Allocation allocation) const;
+	[[nodiscard]] StorageReport GetStorageReport() const;
+
+ private:
+	constexpr static uint32_t NumTopBins  = 32;
+	constexpr static uint32_t BinsPerLeaf = 8;
+	constexpr static uint32_t NumLeafBins = NumTopBins * BinsPerLeaf;
+	constexpr static uint32_t Unused      = std::numeric_limits<uint32_t>::max();
+
+	struct Node {
+		uint32_t DataOffset   = 0;
+		uint32_t DataSize     = 0;
+		uint32_t BinListPrev  = Unused;
+		uint32_t BinListNext  = Unused;
+		uint32_t NeighborPrev = Unused; /** The node directly before this one in the managed range. */
+		uint32_t NeighborNext = Unused; /** The node directly after this one in the managed range. */
+		bool Used             = false;
+	};
+
+	uint32_t InsertNodeIntoBin(uint32_t size, uint32_t dataOffset);
+	void RemoveNodeFromBin(uint32_t nodeIndex);
+
+	uint32_t _size;
+	uint32_t _maxNodes;
+	uint32_t _freeStorage = 0;
+
+	uint32_t _usedBinsTop = 0;
+	std::array<uint8_t, NumTopBins> _usedBins;
+	std::array<uint32_t, NumLeafBins> _binIndices;
+
+	std::vector<Node> _nodes;
+	std::vector<uint32_t> _freeNodes;
+};
+}  // namespace Luna
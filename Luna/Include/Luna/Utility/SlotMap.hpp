@@ -0,0 +1,258 @@
+#pragma once
+
+#include <Luna/Common.hpp>
+#include <Luna/Utility/SpinLock.hpp>
+
+namespace Luna {
+/**
+ * A generational handle into a SlotMap.
+ *
+ * Handles are two 32-bit words and trivially copyable. A handle becomes stale once the object it refers to is erased;
+ * the slot's generation is bumped on erase, so stale handles are detected rather than aliasing a newer object.
+ * Generation 0 is never issued, so a default-constructed handle is always invalid.
+ */
+template <typename T>
+struct SlotHandle {
+	uint32_t Index      = 0;
+	uint32_t Generation = 0;
+
+	[[nodiscard]] uint64_t GetValue() const noexcept {
+		return (uint64_t(Generation) << 32) | uint64_t(Index);
+	}
+
+	[[nodiscard]] explicit operator bool() const noexcept {
+		return Generation != 0;
+	}
+	[[nodiscard]] bool operator==(const SlotHandle& other) const noexcept = default;
+};
+
+/**
+ * A container of objects addressed by generational handles.
+ *
+ * Objects are stored densely in insertion order (modulo erasures), so iterating a SlotMap walks a contiguous array.
+ * Insertion and erasure are O(1); erasing moves the last object into the hole, so pointers and dense indices are only
+ * valid until the next mutation. Handles remain valid until their object is erased.
+ */
+template <typename T>
+class SlotMap {
+ public:
+	using HandleT = SlotHandle<T>;
+
+	[[nodiscard]] size_t Size() const noexcept {
+		return _values.size();
+	}
+	[[nodiscard]] bool Empty() const noexcept {
+		return _values.empty();
+	}
+	[[nodiscard]] T* Data() noexcept {
+		return _values.data();
+	}
+	[[nodiscard]] const T* Data() const noexcept {
+		return _values.data();
+	}
+
+	/** Get the handle of the object currently stored at the given dense index. */
+	[[nodiscard]] HandleT GetHandle(size_t denseIndex) const noexcept {
+		const uint32_t slotIndex = _denseToSlot[denseIndex];
+
+		return HandleT{slotIndex, _slots[slotIndex].Generation};
+	}
+
+	[[nodiscard]] bool Contains(HandleT handle) const noexcept {
+		return handle.Index < _slots.size() && handle.Generation != 0 &&
+		       _slots[handle.Index].Generation == handle.Generation;
+	}
+
+	/** Find the object referenced by the given handle, or nullptr if the handle is stale or invalid. */
+	[[nodiscard]] T* Find(HandleT handle) noexcept {
+		return Contains(handle) ? &_values[_slots[handle.Index].DenseIndex] : nullptr;
+	}
+	[[nodiscard]] const T* Find(HandleT handle) const noexcept {
+		return Contains(handle) ? &_values[_slots[handle.Index].DenseIndex] : nullptr;
+	}
+
+	void Clear() noexcept {
+		for (const auto slotIndex : _denseToSlot) { Release(slotIndex); }
+		_values.clear();
+		_denseToSlot.clear();
+	}
+
+	template <typename... Args>
+	HandleT Emplace(Args&&... args) {
+		if (_values.size() >= InvalidIndex) { throw std::length_error("SlotMap capacity exceeded"); }
+
+		const uint32_t denseIndex = uint32_t(_values.size());
+		_values.emplace_back(std::forward<Args>(args)...);
+
+		uint32_t slotIndex;
+		if (_freeHead != InvalidIndex) {
+			slotIndex = _freeHead;
+			_freeHead = _slots[slotIndex].DenseIndex;
+		} else {
+			slotIndex = uint32_t(_slots.size());
+			_slots.push_back({InvalidIndex, 1});
+		}
+		_slots[slotIndex].DenseIndex = denseIndex;
+		_denseToSlot.push_back(slotIndex);
+
+		return HandleT{slotIndex, _slots[slotIndex].Generation};
+	}
+
+	/** Erase the object referenced by the given handle. Returns false if the handle was stale or invalid. */
+	bool Erase(HandleT handle) {
+		if (!Contains(handle)) { return false; }
+
+		const uint32_t denseIndex = _slots[handle.Index].DenseIndex;
+		const uint32_t lastIndex  = uint32_t(_values.size() - 1);
+		if (denseIndex != lastIndex) {
+			_values[denseIndex]                         = std::move(_values[lastIndex]);
+			_denseToSlot[denseIndex]                    = _denseToSlot[lastIndex];
+			_slots[_denseToSlot[denseIndex]].DenseIndex = denseIndex;
+		}
+		_values.pop_back();
+		_denseToSlot.pop_back();
+		Release(handle.Index);
+
+		return true;
+	}
+
+	HandleT Insert(const T& value) {
+		return Emplace(value);
+	}
+	HandleT Insert(T&& value) {
+		return Emplace(std::move(value));
+	}
+
+	void Reserve(size_t count) {
+		_values.reserve(count);
+		_denseToSlot.reserve(count);
+		_slots.reserve(count);
+	}
+
+	typename std::vector<T>::iterator begin() noexcept {
+		return _values.begin();
+	}
+	typename std::vector<T>::const_iterator begin() const noexcept {
+		return _values.begin();
+	}
+	typename std::vector<T>::iterator end() noexcept {
+		return _values.end();
+	}
+	typename std::vector<T>::const_iterator end() const noexcept {
+		return _values.end();
+	}
+
+ private:
+	constexpr static uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+	/** For a live slot, DenseIndex is the object's position in _values. For a free slot, it links the free list. */
+	struct Slot {
+		uint32_t DenseIndex;
+		uint32_t Generation;
+	};
+
+	void Release(uint32_t slotIndex) noexcept {
+		auto& slot = _slots[slotIndex];
+		if (++slot.Generation == 0) { slot.Generation = 1; }
+		slot.DenseIndex = _freeHead;
+		_freeHead       = slotIndex;
+	}
+
+	std::vector<T> _values;
+	std::vector<uint32_t> _denseToSlot;
+	std::vector<Slot> _slots;
+	uint32_t _freeHead = InvalidIndex;
+};
+
+/**
+ * A SlotMap which may be inserted into, erased from, and read concurrently.
+ *
+ * Since any insertion may reallocate the dense storage, objects are only accessed through callbacks run under a lock.
+ * Once concurrent work has finished, GetUnsafe() exposes the underlying SlotMap for contiguous, lock-free iteration.
+ */
+template <typename T>
+class ThreadSafeSlotMap : private SlotMap<T> {
+ public:
+	using HandleT = SlotHandle<T>;
+
+	[[nodiscard]] size_t Size() const noexcept {
+		RWSpinLockReadHolder holder(_lock);
+		return SlotMap<T>::Size();
+	}
+
+	[[nodiscard]] bool Contains(HandleT handle) const noexcept {
+		RWSpinLockReadHolder holder(_lock);
+		return SlotMap<T>::Contains(handle);
+	}
+
+	void Clear() noexcept {
+		RWSpinLockWriteHolder holder(_lock);
+		SlotMap<T>::Clear();
+	}
+
+	template <typename... Args>
+	HandleT Emplace(Args&&... args) {
+		RWSpinLockWriteHolder holder(_lock);
+		return SlotMap<T>::Emplace(std::forward<Args>(args)...);
+	}
+
+	bool Erase(HandleT handle) {
+		RWSpinLockWriteHolder holder(_lock);
+		return SlotMap<T>::Erase(handle);
+	}
+
+	HandleT Insert(const T& value) {
+		return Emplace(value);
+	}
+	HandleT Insert(T&& value) {
+		return Emplace(std::move(value));
+	}
+
+	/** Invoke func with a const reference to the object, under a shared lock. Returns false if stale. */
+	template <typename F>
+	bool Read(HandleT handle, F&& func) const {
+		RWSpinLockReadHolder holder(_lock);
+		const T* value = SlotMap<T>::Find(handle);
+		if (!value) { return false; }
+		func(*value);
+
+		return true;
+	}
+
+	void Reserve(size_t count) {
+		RWSpinLockWriteHolder holder(_lock);
+		SlotMap<T>::Reserve(count);
+	}
+
+	/** Invoke func with a mutable reference to the object, under an exclusive lock. Returns false if stale. */
+	template <typename F>
+	bool Write(HandleT handle, F&& func) {
+		RWSpinLockWriteHolder holder(_lock);
+		T* value = SlotMap<T>::Find(handle);
+		if (!value) { return false; }
+		func(*value);
+
+		return true;
+	}
+
+	/** Access the underlying SlotMap. The caller must ensure no other thread is using this container. */
+	[[nodiscard]] SlotMap<T>& GetUnsafe() noexcept {
+		return *this;
+	}
+	[[nodiscard]] const SlotMap<T>& GetUnsafe() const noexcept {
+		return *this;
+	}
+
+ private:
+	mutable RWSpinLock _lock;
+};
+}  // namespace Luna
+
+namespace std {
+template <typename T>
+struct hash<Luna::SlotHandle<T>> {
+	size_t operator()(const Luna::SlotHandle<T>& handle) const noexcept {
+		return std::hash<uint64_t>{}(handle.GetValue());
+	}
+};
+}  // namespace std
@@ -0,0 +1,336 @@
+#pragma once
+
+#include <Luna/Common.hpp>
+
+namespace Luna {
+/**
+ * A vector which stores up to N elements inline before touching the heap.
+ *
+ * When Growable is true, exceeding the inline capacity moves the elements into a heap allocation, after which the
+ * container behaves like std::vector. When Growable is false, the capacity is fixed at N and exceeding it throws.
+ * Iterators are plain pointers and are invalidated by any operation which changes the size.
+ *
+ * Use the SmallVector and FixedVector aliases rather than naming this class directly.
+ */
+template <typename T, size_t N, bool Growable>
+class InlineVector {
+	static_assert(N > 0, "InlineVector must have an inline capacity of at least one element");
+
+ public:
+	using value_type             = T;
+	using size_type              = size_t;
+	using difference_type        = std::ptrdiff_t;
+	using reference              = T&;
+	using const_reference        = const T&;
+	using pointer                = T*;
+	using const_pointer          = const T*;
+	using iterator               = T*;
+	using const_iterator         = const T*;
+	using reverse_iterator       = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	InlineVector() noexcept : _data(InlineData()) {}
+	explicit InlineVector(size_type count) : InlineVector() {
+		resize(count);
+	}
+	InlineVector(size_type count, const T& value) : InlineVector() {
+		assign(count, value);
+	}
+	template <std::input_iterator It>
+	InlineVector(It first, It last) : InlineVector() {
+		assign(first, last);
+	}
+	InlineVector(std::initializer_list<T> init) : InlineVector() {
+		assign(init.begin(), init.end());
+	}
+	InlineVector(const InlineVector& other) : InlineVector() {
+		assign(other.begin(), other.end());
+	}
+	InlineVector(InlineVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : InlineVector() {
+		MoveFrom(std::move(other));
+	}
+	~InlineVector() noexcept {
+		clear();
+		Deallocate();
+	}
+
+	InlineVector& operator=(const InlineVector& other) {
+		if (this != &other) { assign(other.begin(), other.end()); }
+
+		return *this;
+	}
+	InlineVector& operator=(InlineVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if (this != &other) {
+			clear();
+			Deallocate();
+			MoveFrom(std::move(other));
+		}
+
+		return *this;
+	}
+	InlineVector& operator=(std::initializer_list<T> init) {
+		assign(init.begin(), init.end());
+
+		return *this;
+	}
+
+	void assign(size_type count, const T& value) {
+		clear();
+		reserve(count);
+		for (size_type i = 0; i < count; ++i) { new (_data + i) T(value); }
+		_size = count;
+	}
+	template <std::input_iterator It>
+	void assign(It first, It last) {
+		clear();
+		if constexpr (std::forward_iterator<It>) { reserve(size_type(std::distance(first, last))); }
+		for (; first != last; ++first) { emplace_back(*first); }
+	}
+
+	[[nodiscard]] reference at(size_type index) {
+		if (index >= _size) { throw std::out_of_range("InlineVector index out of range"); }
+		return _data[index];
+	}
+	[[nodiscard]] const_reference at(size_type index) const {
+		if (index >= _size) { throw std::out_of_range("InlineVector index out of range"); }
+		return _data[index];
+	}
+	[[nodiscard]] reference operator[](size_type index) noexcept {
+		return _data[index];
+	}
+	[[nodiscard]] const_reference operator[](size_type index) const noexcept {
+		return _data[index];
+	}
+	[[nodiscard]] reference front() noexcept {
+		return _data[0];
+	}
+	[[nodiscard]] const_reference front() const noexcept {
+		return _data[0];
+	}
+	[[nodiscard]] reference back() noexcept {
+		return _data[_size - 1];
+	}
+	[[nodiscard]] const_reference back() const noexcept {
+		return _data[_size - 1];
+	}
+	[[nodiscard]] T* data() noexcept {
+		return _data;
+	}
+	[[nodiscard]] const T* data() const noexcept {
+		return _data;
+	}
+
+	[[nodiscard]] iterator begin() noexcept {
+		return _data;
+	}
+	[[nodiscard]] const_iterator begin() const noexcept {
+		return _data;
+	}
+	[[nodiscard]] const_iterator cbegin() const noexcept {
+		return _data;
+	}
+	[[nodiscard]] iterator end() noexcept {
+		return _data + _size;
+	}
+	[[nodiscard]] const_iterator end() const noexcept {
+		return _data + _size;
+	}
+	[[nodiscard]] const_iterator cend() const noexcept {
+		return _data + _size;
+	}
+	[[nodiscard]] reverse_iterator rbegin() noexcept {
+		return reverse_iterator(end());
+	}
+	[[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+	[[nodiscard]] reverse_iterator rend() noexcept {
+		return reverse_iterator(begin());
+	}
+	[[nodiscard]] const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return _size == 0;
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return _size;
+	}
+	[[nodiscard]] size_type capacity() const noexcept {
+		return _capacity;
+	}
+	[[nodiscard]] size_type max_size() const noexcept {
+		if constexpr (Growable) {
+			return std::allocator_traits<std::allocator<T>>::max_size(std::allocator<T>());
+		} else {
+			return N;
+		}
+	}
+	/** Returns true if the elements are currently stored inline, without a heap allocation. */
+	[[nodiscard]] bool IsInline() const noexcept {
+		return _data == InlineData();
+	}
+
+	void reserve(size_type newCapacity) {
+		if (newCapacity > _capacity) { Reallocate(newCapacity); }
+	}
+
+	void clear() noexcept {
+		std::destroy(_data, _data + _size);
+		_size = 0;
+	}
+
+	template <typename... Args>
+	iterator emplace(const_iterator position, Args&&... args) {
+		const auto index = size_type(position - _data);
+		emplace_back(std::forward<Args>(args)...);
+		std::rotate(_data + index, _data + _size - 1, _data + _size);
+
+		return _data + index;
+	}
+	iterator insert(const_iterator position, const T& value) {
+		return emplace(position, value);
+	}
+	iterator insert(const_iterator position, T&& value) {
+		return emplace(position, std::move(value));
+	}
+
+	iterator erase(const_iterator position) {
+		return erase(position, position + 1);
+	}
+	iterator erase(const_iterator first, const_iterator last) {
+		T* dst         = _data + (first - _data);
+		T* src         = _data + (last - _data);
+		const auto end = std::move(src, _data + _size, dst);
+		std::destroy(end, _data + _size);
+		_size = size_type(end - _data);
+
+		return dst;
+	}
+
+	template <typename... Args>
+	reference emplace_back(Args&&... args) {
+		if (_size == _capacity) { return GrowAndEmplaceBack(std::forward<Args>(args)...); }
+
+		T* value = new (_data + _size) T(std::forward<Args>(args)...);
+		++_size;
+
+		return *value;
+	}
+	void push_back(const T& value) {
+		emplace_back(value);
+	}
+	void push_back(T&& value) {
+		emplace_back(std::move(value));
+	}
+	void pop_back() noexcept {
+		--_size;
+		std::destroy_at(_data + _size);
+	}
+
+	void resize(size_type count) {
+		if (count < _size) {
+			std::destroy(_data + count, _data + _size);
+		} else {
+			reserve(count);
+			for (size_type i = _size; i < count; ++i) { new (_data + i) T(); }
+		}
+		_size = count;
+	}
+	void resize(size_type count, const T& value) {
+		if (count < _size) {
+			std::destroy(_data + count, _data + _size);
+		} else {
+			reserve(count);
+			for (size_type i = _size; i < count; ++i) { new (_data + i) T(value); }
+		}
+		_size = count;
+	}
+
+	[[nodiscard]] bool operator==(const InlineVector& other) const {
+		return std::equal(begin(), end(), other.begin(), other.end());
+	}
+
+ private:
+	T* InlineData() noexcept {
+		return reinterpret_cast<T*>(_inline);
+	}
+	const T* InlineData() const noexcept {
+		return reinterpret_cast<const T*>(_inline);
+	}
+
+	size_type NextCapacity(size_type required) const {
+		if constexpr (!Growable) { throw std::length_error("FixedVector capacity exceeded"); }
+
+		return std::max(required, _capacity * 2);
+	}
+
+	void Deallocate() noexcept {
+		if (!IsInline()) { std::allocator<T>().deallocate(_data, _capacity); }
+		_data     = InlineData();
+		_capacity = N;
+	}
+
+	template <typename... Args>
+	reference GrowAndEmplaceBack(Args&&... args) {
+		// Construct the new element before moving the old ones, in case the arguments reference an existing element.
+		const auto newCapacity = NextCapacity(_size + 1);
+		T* newData             = std::allocator<T>().allocate(newCapacity);
+		try {
+			new (newData + _size) T(std::forward<Args>(args)...);
+		} catch (...) {
+			std::allocator<T>().deallocate(newData, newCapacity);
+			throw;
+		}
+		std::uninitialized_move(_data, _data + _size, newData);
+		std::destroy(_data, _data + _size);
+		Deallocate();
+
+		_data     = newData;
+		_capacity = newCapacity;
+
+		return _data[_size++];
+	}
+
+	void MoveFrom(InlineVector&& other) {
+		if (!other.IsInline()) {
+			_data           = other._data;
+			_size           = other._size;
+			_capacity       = other._capacity;
+			other._data     = other.InlineData();
+			other._size     = 0;
+			other._capacity = N;
+		} else {
+			std::uninitialized_move(other._data, other._data + other._size, _data);
+			_size = other._size;
+			other.clear();
+		}
+	}
+
+	void Reallocate(size_type newCapacity) {
+		if constexpr (!Growable) { throw std::length_error("FixedVector capacity exceeded"); }
+
+		T* newData = std::allocator<T>().allocate(newCapacity);
+		std::uninitialized_move(_data, _data + _size, newData);
+		std::destroy(_data, _data + _size);
+		Deallocate();
+
+		_data     = newData;
+		_capacity = newCapacity;
+	}
+
+	alignas(T) std::byte _inline[sizeof(T) * N];
+	T* _data;
+	size_type _size     = 0;
+	size_type _capacity = N;
+};
+
+/** A vector with inline storage for N elements, which spills to the heap when it grows beyond that. */
+template <typename T, size_t N>
+using SmallVector = InlineVector<T, N, true>;
+
+/** A vector with inline storage for N elements and no heap fallback. Growing beyond N throws std::length_error. */
+template <typename T, size_t N>
+using FixedVector = InlineVector<T, N, false>;
+}  // namespace Luna
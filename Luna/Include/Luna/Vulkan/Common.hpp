@@ -155,6 +155,12 @@ struct TimestampReport {
 	double AccumulationsPerFrameContext = 0.0;
 };
 
+/** Device-local memory in use and available to this process, summed over every device-local heap. */
+struct MemoryBudget {
+	vk::DeviceSize Usage  = 0; /** Bytes currently allocated by this process. */
+	vk::DeviceSize Budget = 0; /** Bytes this process can allocate before the driver starts to evict or fail. */
+};
+
 struct QueueInfo {
 	std::array<uint32_t, QueueTypeCount> Families;
 	std::array<uint32_t, QueueTypeCount> Indices;
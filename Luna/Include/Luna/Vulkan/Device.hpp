@@ -74,6 +74,8 @@ class Device : public VulkanObject<Device> {
 	[[nodiscard]] ImageViewHandle CreateImageView(const ImageViewCreateInfo& createInfo,
 	                                              const std::string& debugName = "");
 	[[nodiscard]] SamplerHandle CreateSampler(const SamplerCreateInfo& samplerCI, const std::string& debugName = "");
+	/** Exact when VK_EXT_memory_budget is enabled, otherwise estimated by VMA from the heap sizes. */
+	[[nodiscard]] MemoryBudget GetMemoryBudget();
 	[[nodiscard]] const Sampler& GetStockSampler(StockSampler type) const;
 	[[nodiscard]] RenderPassInfo GetSwapchainRenderPass(
 		SwapchainRenderPassType type = SwapchainRenderPassType::ColorOnly);
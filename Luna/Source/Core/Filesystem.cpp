@@ -2,7 +2,18 @@
 #include <Luna/Core/OSFilesystem.hpp>
 
 namespace Luna {
-static struct FilesystemState { std::unordered_map<std::string, std::unique_ptr<FilesystemBackend>> Protocols; } State;
+// Transparent hashing lets protocol lookups use the string_view taken straight from a Path, without allocating.
+struct ProtocolHash {
+	using is_transparent = void;
+
+	size_t operator()(std::string_view proto) const noexcept {
+		return std::hash<std::string_view>{}(proto);
+	}
+};
+
+static struct FilesystemState {
+	std::unordered_map<std::string, std::unique_ptr<FilesystemBackend>, ProtocolHash, std::equal_to<>> Protocols;
+} State;
 
 /* ================
 ** ===== File =====
@@ -93,7 +104,7 @@ void Filesystem::Shutdown() {
 }
 
 FilesystemBackend* Filesystem::GetBackend(std::string_view proto) {
-	const auto it = State.Protocols.find(proto.empty() ? "file" : std::string(proto));
+	const auto it = State.Protocols.find(proto.empty() ? std::string_view("file") : proto);
 	if (it == State.Protocols.end()) { return nullptr; }
 
 	return it->second.get();
@@ -105,7 +116,7 @@ void Filesystem::RegisterProtocol(std::string_view proto, std::unique_ptr<Filesy
 }
 
 void Filesystem::UnregisterProtocol(std::string_view proto) {
-	const auto it = State.Protocols.find(std::string(proto));
+	const auto it = State.Protocols.find(proto);
 	if (it != State.Protocols.end()) { State.Protocols.erase(it); }
 }
 
@@ -162,7 +173,7 @@ FileMappingHandle Filesystem::OpenTransactionalMapping(const Path& path, size_t
 	auto file = Open(path, FileMode::WriteOnlyTransactional);
 	if (!file) { return {}; }
 
-	return file->Map();
+	return file->MapWrite(size);
 }
 
 FileMappingHandle Filesystem::OpenWriteOnlyMapping(const Path& path) {
@@ -259,15 +270,15 @@ std::vector<ListEntry> ScratchFilesystem::List(const Path& path) {
 	if (!path.IsRoot()) { return {}; }
 
 	std::vector<ListEntry> list;
-	for (const auto& [path, file] : _files) { list.push_back({path, PathType::File}); }
+	for (const auto& [path, file] : _files) { list.push_back({Path(path), PathType::File}); }
 
 	return list;
 }
 
 FileHandle ScratchFilesystem::Open(const Path& path, FileMode mode) {
-	const auto it = _files.find(path);
+	const auto it = _files.find(path.String());
 	if (it == _files.end()) {
-		auto& file = _files[path];
+		auto& file = _files[path.String()];
 		file       = std::make_unique<ScratchFile>();
 
 		return MakeHandle<ScratchFilesystemFile>(*file);
@@ -277,7 +288,7 @@ FileHandle ScratchFilesystem::Open(const Path& path, FileMode mode) {
 }
 
 bool ScratchFilesystem::Stat(const Path& path, FileStat& stat) const {
-	const auto it = _files.find(path);
+	const auto it = _files.find(path.String());
 	if (it == _files.end()) { return false; }
 
 	stat.Size         = it->second->size();
@@ -0,0 +1,352 @@
+#include <Luna/Core/OSFilesystem.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#	include <sys/inotify.h>
+#endif
+
+namespace Luna {
+struct WatchHandler {
+	Luna::Path Path;
+	std::function<void(const FileNotifyInfo&)> Function;
+	int WatchDescriptor = -1;
+};
+
+struct PosixState {
+	int NotifyFD                = -1;
+	FileNotifyHandle NextHandle = 0;
+	std::unordered_map<FileNotifyHandle, WatchHandler> Handlers;
+};
+
+class OSMappedFile : public File {
+ public:
+	OSMappedFile(const std::filesystem::path& path, FileMode mode) {
+		int flags = 0;
+
+		const auto dir = path.parent_path();
+
+		switch (mode) {
+			case FileMode::ReadOnly:
+				flags = O_RDONLY;
+				break;
+
+			case FileMode::ReadWrite:
+				if (!std::filesystem::is_directory(dir) && !std::filesystem::create_directories(dir)) {
+					throw std::runtime_error("Could not create directories for file!");
+				}
+				flags = O_RDWR | O_CREAT;
+				break;
+
+			case FileMode::WriteOnly:
+			case FileMode::WriteOnlyTransactional:
+				if (!std::filesystem::is_directory(dir) && !std::filesystem::create_directories(dir)) {
+					throw std::runtime_error("Could not create directories for file!");
+				}
+				// Writes go through a shared mapping, which needs read access as well.
+				flags = O_RDWR | O_CREAT | O_TRUNC;
+				break;
+		}
+
+		// Transactional writes go to a temporary file, which only replaces the real one once it is complete.
+		if (mode == FileMode::WriteOnlyTransactional) {
+			_renameFromOnClose = path;
+			_renameFromOnClose += ".tmp";
+			_renameToOnClose = path;
+		}
+
+		const auto p = _renameFromOnClose.empty() ? path : _renameFromOnClose;
+		_file        = ::open(p.c_str(), flags | O_CLOEXEC, 0644);
+		if (_file < 0) { throw std::runtime_error("Failed to open file!"); }
+
+		if (mode != FileMode::WriteOnly && mode != FileMode::WriteOnlyTransactional) {
+			struct stat buffer;
+			if (::fstat(_file, &buffer) < 0) {
+				::close(_file);
+				throw std::runtime_error("Failed to query file size!");
+			}
+			_size = uint64_t(buffer.st_size);
+		}
+	}
+
+	~OSMappedFile() noexcept {
+		if (_file >= 0) { ::close(_file); }
+		if (!_renameFromOnClose.empty()) { ::rename(_renameFromOnClose.c_str(), _renameToOnClose.c_str()); }
+	}
+
+	virtual IntrusivePtr<FileMapping> MapSubset(uint64_t offset, size_t range) override {
+		static const uint64_t pageSize = uint64_t(::sysconf(_SC_PAGESIZE));
+
+		if (offset + range > _size) { return {}; }
+
+		const uint64_t beginMap   = offset & ~(pageSize - 1);
+		const uint64_t endMapping = offset + range;
+		const size_t mappedSize   = endMapping - beginMap;
+		// An empty mapping is not allowed, but an empty file is still valid to read.
+		if (mappedSize == 0) { return MakeHandle<FileMapping>(ReferenceFromThis(), offset, nullptr, 0, 0, 0); }
+
+		void* mapped = ::mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, _file, off_t(beginMap));
+		if (mapped == MAP_FAILED) { return {}; }
+
+		return MakeHandle<FileMapping>(ReferenceFromThis(), offset, mapped, mappedSize, offset - beginMap, range);
+	}
+
+	virtual IntrusivePtr<FileMapping> MapWrite(size_t range) override {
+		if (::ftruncate(_file, off_t(range)) < 0) { return {}; }
+		_size = range;
+		if (range == 0) { return MakeHandle<FileMapping>(ReferenceFromThis(), 0, nullptr, 0, 0, 0); }
+
+		void* mapped = ::mmap(nullptr, range, PROT_READ | PROT_WRITE, MAP_SHARED, _file, 0);
+		if (mapped == MAP_FAILED) { return {}; }
+
+		return MakeHandle<FileMapping>(ReferenceFromThis(), 0, mapped, range, 0, range);
+	}
+
+	virtual uint64_t GetSize() override {
+		return _size;
+	}
+
+	virtual void Unmap(void* mapped, size_t range) override {
+		if (mapped) { ::munmap(mapped, range); }
+	}
+
+	static FileHandle Open(const std::filesystem::path& path, FileMode mode) {
+		try {
+			return MakeHandle<OSMappedFile>(path, mode);
+		} catch (const std::exception& e) {
+			Log::Error("Filesystem",
+			           "Failed to open file '{}' for {}: {}",
+			           path.string(),
+			           mode == FileMode::ReadOnly ? "reading" : "writing",
+			           e.what());
+
+			return {};
+		}
+	}
+
+ private:
+	int _file      = -1;
+	uint64_t _size = 0;
+	std::filesystem::path _renameFromOnClose;
+	std::filesystem::path _renameToOnClose;
+};
+
+OSFilesystem::OSFilesystem(const Path& base) : _basePath(base.String()) {
+	std::filesystem::create_directories(GetFilesystemPath(""));
+
+	auto* data = new PosixState;
+#ifdef __linux__
+	data->NotifyFD = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (data->NotifyFD < 0) { Log::Error("Filesystem", "Failed to create inotify instance, files cannot be watched"); }
+#endif
+	_data.reset(reinterpret_cast<uint8_t*>(data));
+}
+
+OSFilesystem::~OSFilesystem() noexcept {
+	if (_data) {
+		// The state was not allocated as bytes, so it is deleted as what it is.
+		PosixState* data = reinterpret_cast<PosixState*>(_data.release());
+		if (data->NotifyFD >= 0) { ::close(data->NotifyFD); }
+		delete data;
+	}
+}
+
+std::filesystem::path OSFilesystem::GetFilesystemPath(const Path& path) const {
+	const auto norm = path.Normalized();
+	if (!norm.ValidateBounds()) { return ""; }
+
+	if (path.IsAbsolute()) { return _basePath / std::string(norm).substr(1); }
+
+	return _basePath / std::string(norm);
+}
+
+bool OSFilesystem::MoveReplace(const Path& dst, const Path& src) {
+	if (!dst.ValidateBounds() || !src.ValidateBounds()) { return false; }
+
+	auto dstPath = GetFilesystemPath(dst.Normalized());
+	auto srcPath = GetFilesystemPath(src.Normalized());
+
+	return ::rename(srcPath.c_str(), dstPath.c_str()) == 0;
+}
+
+bool OSFilesystem::MoveYield(const Path& dst, const Path& src) {
+	if (!dst.ValidateBounds() || !src.ValidateBounds()) { return false; }
+
+	auto dstPath = GetFilesystemPath(dst.Normalized());
+	auto srcPath = GetFilesystemPath(src.Normalized());
+
+	// Linking fails if the destination exists, where renaming would silently replace it.
+	if (::link(srcPath.c_str(), dstPath.c_str()) < 0) { return false; }
+
+	return ::unlink(srcPath.c_str()) == 0;
+}
+
+bool OSFilesystem::Remove(const Path& path) {
+	if (!path.ValidateBounds()) { return false; }
+
+	const auto p = GetFilesystemPath(path.Normalized());
+
+	return ::unlink(p.c_str()) == 0;
+}
+
+int OSFilesystem::GetWatchFD() const {
+	if (!_data) { return -1; }
+	const PosixState* data = reinterpret_cast<const PosixState*>(_data.get());
+
+	return data->NotifyFD;
+}
+
+std::vector<ListEntry> OSFilesystem::List(const Path& path) {
+	if (!path.ValidateBounds()) { return {}; }
+
+	const std::filesystem::path base = std::string(path);
+	std::vector<ListEntry> entries;
+	std::error_code error;
+	std::filesystem::directory_iterator it(GetFilesystemPath(path), error);
+	if (error) { return entries; }
+
+	for (const auto& dirEntry : it) {
+		ListEntry entry;
+		if (dirEntry.is_directory(error)) {
+			entry.Type = PathType::Directory;
+		} else if (dirEntry.is_regular_file(error)) {
+			entry.Type = PathType::File;
+		} else {
+			entry.Type = PathType::Special;
+		}
+
+		entry.Path = (base / dirEntry.path().filename()).string();
+		entries.push_back(std::move(entry));
+	}
+
+	return entries;
+}
+
+FileHandle OSFilesystem::Open(const Path& path, FileMode mode) {
+	if (!path.ValidateBounds()) { return {}; }
+
+	return OSMappedFile::Open(GetFilesystemPath(path), mode);
+}
+
+bool OSFilesystem::Stat(const Path& path, FileStat& stat) const {
+	if (!path.ValidateBounds()) { return false; }
+
+	const auto p = GetFilesystemPath(path);
+	struct stat buffer;
+	if (::stat(p.c_str(), &buffer) < 0) { return false; }
+
+	if (S_ISREG(buffer.st_mode)) {
+		stat.Type = PathType::File;
+	} else if (S_ISDIR(buffer.st_mode)) {
+		stat.Type = PathType::Directory;
+	} else {
+		stat.Type = PathType::Special;
+	}
+
+	stat.Size         = uint64_t(buffer.st_size);
+	stat.LastModified = buffer.st_mtime;
+
+	return true;
+}
+
+void OSFilesystem::UnwatchFile(FileNotifyHandle handle) {
+	if (!_data) { return; }
+	PosixState* data = reinterpret_cast<PosixState*>(_data.get());
+
+	const auto it = data->Handlers.find(handle);
+	if (it == data->Handlers.end()) { return; }
+
+#ifdef __linux__
+	// Watching the same path twice shares a watch descriptor, which must outlive every handler using it.
+	const int wd         = it->second.WatchDescriptor;
+	const auto SameWatch = [&](const auto& handler) {
+		return handler.first != it->first && handler.second.WatchDescriptor == wd;
+	};
+	if (std::ranges::none_of(data->Handlers, SameWatch)) { ::inotify_rm_watch(data->NotifyFD, wd); }
+#endif
+	data->Handlers.erase(it);
+}
+
+void OSFilesystem::Update() {
+#ifdef __linux__
+	if (!_data) { return; }
+	PosixState* data = reinterpret_cast<PosixState*>(_data.get());
+	if (data->NotifyFD < 0) { return; }
+
+	alignas(inotify_event) char buffer[4096];
+	while (true) {
+		const auto bytesRead = ::read(data->NotifyFD, buffer, sizeof(buffer));
+		if (bytesRead <= 0) { break; }
+
+		for (ssize_t offset = 0; offset < bytesRead;) {
+			const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + event->len;
+
+			FileNotifyType type;
+			if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+				type = FileNotifyType::FileCreated;
+			} else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+				type = FileNotifyType::FileDeleted;
+			} else if (event->mask & IN_CLOSE_WRITE) {
+				type = FileNotifyType::FileChanged;
+			} else {
+				continue;
+			}
+
+			for (auto& handler : data->Handlers) {
+				if (handler.second.WatchDescriptor != event->wd || !handler.second.Function) { continue; }
+
+				FileNotifyInfo notify;
+				notify.Handle = handler.first;
+				notify.Path   = event->len > 0 ? handler.second.Path / std::string_view(event->name) : handler.second.Path;
+				notify.Type   = type;
+				handler.second.Function(notify);
+			}
+		}
+	}
+#endif
+}
+
+FileNotifyHandle OSFilesystem::WatchFile(const Path& path, std::function<void(const FileNotifyInfo&)> func) {
+	if (!_data || !path.ValidateBounds()) { return -1; }
+
+#ifdef __linux__
+	PosixState* data = reinterpret_cast<PosixState*>(_data.get());
+	if (data->NotifyFD < 0) { return -1; }
+
+	FileStat stat = {};
+	if (!Stat(path, stat)) {
+		Log::Error("Filesystem", "Cannot watch path '{}': File or folder does not exist.", path);
+
+		return -1;
+	}
+
+	const auto fsPath   = GetFilesystemPath(path);
+	const uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+	const int wd        = ::inotify_add_watch(data->NotifyFD, fsPath.c_str(), mask);
+	if (wd < 0) {
+		Log::Error("Filesystem", "Cannot watch path '{}': Failed to add inotify watch.", path);
+
+		return -1;
+	}
+
+	data->NextHandle++;
+
+	WatchHandler handler;
+	handler.Path            = _protocol + "://" + path.String();
+	handler.Function        = std::move(func);
+	handler.WatchDescriptor = wd;
+
+	data->Handlers[data->NextHandle] = std::move(handler);
+
+	return data->NextHandle;
+#else
+	Log::Warning("Filesystem", "Cannot watch path '{}': Watching is only supported on Linux and Windows.", path);
+
+	return -1;
+#endif
+}
+}  // namespace Luna
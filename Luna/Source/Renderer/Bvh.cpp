@@ -0,0 +1,374 @@
+#include <Luna/Core/Threading.hpp>
+#include <Luna/Renderer/Bvh.hpp>
+#include <numeric>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	define LUNA_BVH_SSE 1
+#	include <xmmintrin.h>
+#endif
+
+namespace Luna {
+// Number of buckets primitives are sorted into along each axis when searching for the cheapest split.
+constexpr static uint32_t SahBinCount = 16;
+// Below this depth, nodes are split with the surface area heuristic. Deeper nodes are split at the median, which bounds
+// the depth of the tree (and so the traversal stack) even for primitive distributions the heuristic handles badly.
+constexpr static uint32_t MaxSahDepth = 24;
+// Parallel builds hand subtrees of at most this many primitives to worker threads.
+constexpr static uint32_t ParallelSubtreeSize = 4096;
+
+struct Bvh::BuildRange {
+	uint32_t Begin;
+	uint32_t End;
+	uint32_t Depth;
+	BvhBounds Bounds;
+	BvhBounds Centers;
+
+	[[nodiscard]] uint32_t Count() const noexcept {
+		return End - Begin;
+	}
+};
+
+struct Bvh::BuildContext {
+	std::span<const BvhBounds> Bounds;
+	std::atomic_uint32_t NodeCount = 0;
+	std::vector<std::pair<uint32_t, BuildRange>> Deferred; /** Subtrees left for worker threads, by the slot they fill. */
+};
+
+BvhBounds BvhBounds::Transform(const glm::mat4& transform) const noexcept {
+	if (Empty()) { return *this; }
+
+	const glm::vec3 center    = glm::vec3(transform * glm::vec4(Center(), 1.0f));
+	const glm::vec3 halfSize  = (Max - Min) * 0.5f;
+	const glm::vec3 newExtent = glm::abs(glm::vec3(transform[0])) * halfSize.x +
+	                            glm::abs(glm::vec3(transform[1])) * halfSize.y +
+	                            glm::abs(glm::vec3(transform[2])) * halfSize.z;
+
+	return {center - newExtent, center + newExtent};
+}
+
+static void GetRangeBounds(std::span<const BvhBounds> bounds,
+                           std::span<const uint32_t> primitives,
+                           BvhBounds& extent,
+                           BvhBounds& centers) {
+	extent  = {};
+	centers = {};
+	for (const auto primitive : primitives) {
+		extent.Extend(bounds[primitive]);
+		centers.Extend(bounds[primitive].Center());
+	}
+}
+
+/**
+ * Reorder primitives into two groups and return the size of the first. The split is the cheapest found by the binned
+ * surface area heuristic, or the median along the widest axis when sah is false.
+ */
+static uint32_t PartitionPrimitives(std::span<const BvhBounds> bounds,
+                                    std::span<uint32_t> primitives,
+                                    const BvhBounds& centers,
+                                    bool sah) {
+	const auto count  = uint32_t(primitives.size());
+	const auto extent = centers.Max - centers.Min;
+
+	const auto GetBin = [&](uint32_t primitive, int axis, float scale) {
+		const float offset = (bounds[primitive].Center()[axis] - centers.Min[axis]) * scale;
+
+		return std::min(SahBinCount - 1, uint32_t(offset));
+	};
+
+	if (sah) {
+		struct Bin {
+			BvhBounds Bounds;
+			uint32_t Count = 0;
+		};
+		float bestCost     = std::numeric_limits<float>::max();
+		int bestAxis       = -1;
+		uint32_t bestSplit = 0;
+		for (int axis = 0; axis < 3; ++axis) {
+			if (!(extent[axis] > 0.0f)) { continue; }
+
+			std::array<Bin, SahBinCount> bins;
+			const float scale = SahBinCount / extent[axis];
+			for (const auto primitive : primitives) {
+				auto& bin = bins[GetBin(primitive, axis, scale)];
+				bin.Bounds.Extend(bounds[primitive]);
+				++bin.Count;
+			}
+
+			// Sweep from the right for the cost of everything after each split, then from the left to find the cheapest.
+			std::array<float, SahBinCount - 1> rightCosts;
+			BvhBounds right;
+			uint32_t rightCount = 0;
+			for (uint32_t i = SahBinCount - 1; i > 0; --i) {
+				right.Extend(bins[i].Bounds);
+				rightCount += bins[i].Count;
+				rightCosts[i - 1] = right.SurfaceArea() * float(rightCount);
+			}
+			BvhBounds left;
+			uint32_t leftCount = 0;
+			for (uint32_t i = 0; i < SahBinCount - 1; ++i) {
+				left.Extend(bins[i].Bounds);
+				leftCount += bins[i].Count;
+				if (leftCount == 0 || leftCount == count) { continue; }
+
+				const float cost = left.SurfaceArea() * float(leftCount) + rightCosts[i];
+				if (cost < bestCost) {
+					bestCost  = cost;
+					bestAxis  = axis;
+					bestSplit = i;
+				}
+			}
+		}
+
+		if (bestAxis >= 0) {
+			const float scale = SahBinCount / extent[bestAxis];
+			const auto middle = std::partition(primitives.begin(), primitives.end(), [&](uint32_t primitive) {
+				return GetBin(primitive, bestAxis, scale) <= bestSplit;
+			});
+
+			return uint32_t(middle - primitives.begin());
+		}
+	}
+
+	// Either a median split was asked for, or every center coincides and any split is as good as another.
+	const int axis    = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+	const auto middle = primitives.begin() + count / 2;
+	std::nth_element(primitives.begin(), middle, primitives.end(), [&](uint32_t a, uint32_t b) {
+		return bounds[a].Center()[axis] < bounds[b].Center()[axis];
+	});
+
+	return count / 2;
+}
+
+void Bvh::Build(std::span<const BvhBounds> bounds, bool parallel) {
+	std::vector<uint32_t> primitives(bounds.size());
+	std::iota(primitives.begin(), primitives.end(), 0u);
+	Build(bounds, primitives, parallel);
+}
+
+void Bvh::Build(std::span<const BvhBounds> bounds, std::span<const uint32_t> primitives, bool parallel) {
+	Clear();
+	if (primitives.empty()) { return; }
+
+	// Every node but the root has at least two children, and every leaf at least one primitive, so there can be no more
+	// nodes than primitives. Allocating them all up front lets worker threads claim nodes with a single counter.
+	const auto primitiveCount = uint32_t(primitives.size());
+	_primitives.assign(primitives.begin(), primitives.end());
+	_nodes.resize(primitiveCount);
+	_parents.resize(primitiveCount, Invalid);
+	_leafSlots.resize(bounds.size(), Invalid);
+
+	BuildContext context;
+	context.Bounds = bounds;
+	BuildRange root{.Begin = 0, .End = primitiveCount, .Depth = 0};
+	GetRangeBounds(bounds, _primitives, root.Bounds, root.Centers);
+	BuildNode(context, root, parallel && primitiveCount > ParallelSubtreeSize);
+
+	if (!context.Deferred.empty()) {
+		auto group = Threading::CreateTaskGroup();
+		for (const auto& [slot, range] : context.Deferred) {
+			group->Enqueue([this, &context, slot, range]() {
+				const auto childIndex               = BuildNode(context, range, false);
+				_nodes[slot / 4].Children[slot % 4] = childIndex;
+				_parents[childIndex]                = slot;
+			});
+		}
+		group->Wait();
+	}
+
+	_nodes.resize(context.NodeCount);
+	_parents.resize(context.NodeCount);
+	_bounds = root.Bounds;
+}
+
+void Bvh::Clear() {
+	_nodes.clear();
+	_primitives.clear();
+	_parents.clear();
+	_leafSlots.clear();
+	_bounds = {};
+}
+
+void Bvh::Refit(std::span<const BvhBounds> bounds, std::span<const uint32_t> changed) {
+	for (const auto primitive : changed) {
+		if (primitive >= _leafSlots.size() || _leafSlots[primitive] == Invalid) { continue; }
+
+		uint32_t slot         = _leafSlots[primitive];
+		const auto& leafNode  = _nodes[slot / 4];
+		const auto firstEntry = leafNode.Children[slot % 4];
+		const auto entryCount = leafNode.Counts[slot % 4];
+		BvhBounds childBounds;
+		for (uint32_t i = 0; i < entryCount; ++i) { childBounds.Extend(bounds[_primitives[firstEntry + i]]); }
+
+		// Walk towards the root, stopping as soon as a box is left unchanged.
+		while (SetChildBounds(_nodes[slot / 4], slot % 4, childBounds)) {
+			const uint32_t node = slot / 4;
+			childBounds         = GetNodeBounds(_nodes[node]);
+			if (node == 0) {
+				_bounds = childBounds;
+				break;
+			}
+			slot = _parents[node];
+		}
+	}
+}
+
+uint32_t Bvh::BuildNode(BuildContext& context, const BuildRange& range, bool defer) {
+	const uint32_t nodeIndex = context.NodeCount++;
+
+	const auto MakeRange = [&](uint32_t begin, uint32_t end) {
+		BuildRange child{.Begin = begin, .End = end, .Depth = range.Depth + 1};
+		GetRangeBounds(context.Bounds, std::span(_primitives).subspan(begin, end - begin), child.Bounds, child.Centers);
+
+		return child;
+	};
+
+	// Split the child with the largest surface area until there are four, or every child is small enough to be a leaf.
+	std::array<BuildRange, 4> children;
+	uint32_t childCount = 1;
+	children[0]         = range;
+	while (childCount < 4) {
+		uint32_t largest  = Invalid;
+		float largestArea = -1.0f;
+		for (uint32_t i = 0; i < childCount; ++i) {
+			if (children[i].Count() > LeafSize && children[i].Bounds.SurfaceArea() > largestArea) {
+				largest     = i;
+				largestArea = children[i].Bounds.SurfaceArea();
+			}
+		}
+		if (largest == Invalid) { break; }
+
+		const auto parent      = children[largest];
+		const auto entries     = std::span(_primitives).subspan(parent.Begin, parent.Count());
+		const bool sah         = range.Depth < MaxSahDepth;
+		const auto split       = parent.Begin + PartitionPrimitives(context.Bounds, entries, parent.Centers, sah);
+		children[largest]      = MakeRange(parent.Begin, split);
+		children[childCount++] = MakeRange(split, parent.End);
+	}
+
+	auto& node      = _nodes[nodeIndex];
+	node.ChildCount = childCount;
+	for (uint32_t i = 0; i < 4; ++i) {
+		node.Children[i] = Invalid;
+		node.Counts[i]   = 0;
+		if (i >= childCount) {
+			SetChildBounds(node, i, {});
+			continue;
+		}
+
+		const auto& child   = children[i];
+		const uint32_t slot = nodeIndex * 4 + i;
+		SetChildBounds(node, i, child.Bounds);
+		if (child.Count() <= LeafSize) {
+			node.Children[i] = child.Begin;
+			node.Counts[i]   = child.Count();
+			for (uint32_t p = child.Begin; p < child.End; ++p) { _leafSlots[_primitives[p]] = slot; }
+		} else if (defer && child.Count() <= ParallelSubtreeSize) {
+			context.Deferred.push_back({slot, child});
+		} else {
+			const auto childIndex = BuildNode(context, child, defer);
+			node.Children[i]      = childIndex;
+			_parents[childIndex]  = slot;
+		}
+	}
+
+	return nodeIndex;
+}
+
+bool Bvh::SetChildBounds(Node& node, uint32_t child, const BvhBounds& bounds) {
+	if (node.MinX[child] == bounds.Min.x && node.MinY[child] == bounds.Min.y && node.MinZ[child] == bounds.Min.z &&
+	    node.MaxX[child] == bounds.Max.x && node.MaxY[child] == bounds.Max.y && node.MaxZ[child] == bounds.Max.z) {
+		return false;
+	}
+
+	node.MinX[child] = bounds.Min.x;
+	node.MinY[child] = bounds.Min.y;
+	node.MinZ[child] = bounds.Min.z;
+	node.MaxX[child] = bounds.Max.x;
+	node.MaxY[child] = bounds.Max.y;
+	node.MaxZ[child] = bounds.Max.z;
+
+	return true;
+}
+
+BvhBounds Bvh::GetNodeBounds(const Node& node) {
+	BvhBounds bounds;
+	for (uint32_t i = 0; i < node.ChildCount; ++i) {
+		bounds.Min = glm::min(bounds.Min, glm::vec3(node.MinX[i], node.MinY[i], node.MinZ[i]));
+		bounds.Max = glm::max(bounds.Max, glm::vec3(node.MaxX[i], node.MaxY[i], node.MaxZ[i]));
+	}
+
+	return bounds;
+}
+
+uint32_t Bvh::IntersectNode(const Node& node,
+                            const glm::vec3& origin,
+                            const glm::vec3& inverseDirection,
+                            float maxDistance,
+                            float* distances) {
+	// On each axis, the ray enters through the min side when travelling towards +axis, and the max side otherwise.
+	// Choosing sides per ray rather than per box also rejects empty boxes, whose min lies beyond their max.
+	const bool positiveX = inverseDirection.x >= 0.0f;
+	const bool positiveY = inverseDirection.y >= 0.0f;
+	const bool positiveZ = inverseDirection.z >= 0.0f;
+	const float* nearX   = positiveX ? node.MinX : node.MaxX;
+	const float* nearY   = positiveY ? node.MinY : node.MaxY;
+	const float* nearZ   = positiveZ ? node.MinZ : node.MaxZ;
+	const float* farX    = positiveX ? node.MaxX : node.MinX;
+	const float* farY    = positiveY ? node.MaxY : node.MinY;
+	const float* farZ    = positiveZ ? node.MaxZ : node.MinZ;
+	const uint32_t mask  = (1u << node.ChildCount) - 1;
+
+#ifdef LUNA_BVH_SSE
+	const auto Slab = [](const float* planes, float origin, float inverseDirection) {
+		return _mm_mul_ps(_mm_sub_ps(_mm_load_ps(planes), _mm_set1_ps(origin)), _mm_set1_ps(inverseDirection));
+	};
+	const __m128 tNear = _mm_max_ps(_mm_max_ps(Slab(nearX, origin.x, inverseDirection.x),
+	                                           Slab(nearY, origin.y, inverseDirection.y)),
+	                                _mm_max_ps(Slab(nearZ, origin.z, inverseDirection.z), _mm_setzero_ps()));
+	const __m128 tFar  = _mm_min_ps(_mm_min_ps(Slab(farX, origin.x, inverseDirection.x),
+	                                           Slab(farY, origin.y, inverseDirection.y)),
+	                                _mm_min_ps(Slab(farZ, origin.z, inverseDirection.z), _mm_set1_ps(maxDistance)));
+	_mm_store_ps(distances, tNear);
+
+	return uint32_t(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar))) & mask;
+#else
+	uint32_t hits = 0;
+	for (uint32_t i = 0; i < 4; ++i) {
+		const float tNear = std::max(std::max((nearX[i] - origin.x) * inverseDirection.x,
+		                                      (nearY[i] - origin.y) * inverseDirection.y),
+		                             std::max((nearZ[i] - origin.z) * inverseDirection.z, 0.0f));
+		const float tFar  = std::min(std::min((farX[i] - origin.x) * inverseDirection.x,
+		                                      (farY[i] - origin.y) * inverseDirection.y),
+		                             std::min((farZ[i] - origin.z) * inverseDirection.z, maxDistance));
+		distances[i]      = tNear;
+		if (tNear <= tFar) { hits |= 1u << i; }
+	}
+
+	return hits & mask;
+#endif
+}
+
+uint32_t Bvh::IntersectNode(const Node& node, std::span<const glm::vec4, 6> planes) {
+	uint32_t inside = (1u << node.ChildCount) - 1;
+	for (const auto& plane : planes) {
+		// Only the corner furthest along the plane's normal needs testing. If it is outside, so is the rest of the box.
+		const float* x = plane.x >= 0.0f ? node.MaxX : node.MinX;
+		const float* y = plane.y >= 0.0f ? node.MaxY : node.MinY;
+		const float* z = plane.z >= 0.0f ? node.MaxZ : node.MinZ;
+
+#ifdef LUNA_BVH_SSE
+		const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(x), _mm_set1_ps(plane.x)),
+		                                              _mm_mul_ps(_mm_load_ps(y), _mm_set1_ps(plane.y))),
+		                                   _mm_mul_ps(_mm_load_ps(z), _mm_set1_ps(plane.z)));
+		inside &= uint32_t(_mm_movemask_ps(_mm_cmpge_ps(distance, _mm_set1_ps(plane.w))));
+#else
+		for (uint32_t i = 0; i < 4; ++i) {
+			if (!(x[i] * plane.x + y[i] * plane.y + z[i] * plane.z >= plane.w)) { inside &= ~(1u << i); }
+		}
+#endif
+		if (inside == 0) { break; }
+	}
+
+	return inside;
+}
+}  // namespace Luna
@@ -0,0 +1,155 @@
+#include <Luna/Renderer/GeometryArena.hpp>
+#include <Luna/Renderer/Renderer.hpp>
+#include <Luna/Renderer/Scene.hpp>
+#include <Luna/Vulkan/Buffer.hpp>
+#include <Luna/Vulkan/CommandBuffer.hpp>
+#include <Luna/Vulkan/Device.hpp>
+
+namespace Luna {
+GeometryArena::GeometryArena(VertexFormat format, const StreamSizes& capacities)
+		: _vertexFormat(format),
+		  _allocators{OffsetAllocator(capacities[0]),
+		              OffsetAllocator(capacities[1]),
+		              OffsetAllocator(capacities[2]),
+		              OffsetAllocator(capacities[3])} {
+	auto& device  = Renderer::GetDevice();
+	_vertexStride = format == VertexFormat::Quantized ? sizeof(QuantizedVertex) : sizeof(Vertex);
+
+	const auto CreateStreamBuffer = [&](Stream stream, size_t elementSize, const std::string& name) {
+		const Vulkan::BufferCreateInfo bufferCI(Vulkan::BufferDomain::Device,
+		                                        std::max<size_t>(capacities[size_t(stream)], 1) * elementSize);
+
+		return device.CreateBuffer(bufferCI, nullptr, name);
+	};
+	_positionBuffer = CreateStreamBuffer(Stream::Vertices, sizeof(glm::vec3), "Geometry Positions");
+	_vertexBuffer   = CreateStreamBuffer(Stream::Vertices, _vertexStride, "Geometry Vertices");
+	_indexBuffer    = CreateStreamBuffer(Stream::Indices, sizeof(uint32_t), "Geometry Indices");
+	_triangleBuffer = CreateStreamBuffer(Stream::Triangles, sizeof(uint8_t), "Geometry Triangles");
+	_meshletBuffer  = CreateStreamBuffer(Stream::Meshlets, sizeof(Meshlet), "Geometry Meshlets");
+
+	_pendingFrees.resize(device.GetFramesInFlight());
+}
+
+GeometryArena::Handle GeometryArena::Allocate(const StreamSizes& counts) {
+	Allocation allocation;
+	for (size_t s = 0; s < StreamCount; ++s) {
+		// Empty streams take no space, and sit at offset 0.
+		if (counts[s] == 0) { continue; }
+
+		allocation.Ranges[s] = _allocators[s].Allocate(counts[s]);
+		if (!allocation.Ranges[s]) {
+			for (size_t i = 0; i < s; ++i) { _allocators[i].Free(allocation.Ranges[i]); }
+			return {};
+		}
+		allocation.Offsets[s] = allocation.Ranges[s].Offset;
+		allocation.Counts[s]  = counts[s];
+	}
+
+	return _allocations.Insert(allocation);
+}
+
+void GeometryArena::Free(Handle handle) {
+	if (!_allocations.Contains(handle)) { return; }
+
+	_pendingFrees[Renderer::GetDevice().GetFrameIndex()].push_back(handle);
+}
+
+void GeometryArena::BeginFrame() {
+	ReleaseFrees(_pendingFrees[Renderer::GetDevice().GetFrameIndex()]);
+}
+
+void GeometryArena::ReleaseFrees(std::vector<Handle>& frees) {
+	for (const auto handle : frees) {
+		const auto* allocation = _allocations.Find(handle);
+		if (!allocation) { continue; }
+
+		for (size_t s = 0; s < StreamCount; ++s) { _allocators[s].Free(allocation->Ranges[s]); }
+		_allocations.Erase(handle);
+	}
+	frees.clear();
+}
+
+bool GeometryArena::Defragment() {
+	auto& device = Renderer::GetDevice();
+	device.WaitIdle();
+	for (auto& frees : _pendingFrees) { ReleaseFrees(frees); }
+
+	struct Move {
+		Vulkan::Buffer* Buffer;
+		vk::DeviceSize From;
+		vk::DeviceSize To;
+		vk::DeviceSize Size;
+	};
+	std::vector<Move> moves;
+	vk::DeviceSize scratchSize = 0;
+
+	// Re-allocating each stream's live ranges in address order, from an empty allocator, packs them from the start.
+	for (size_t s = 0; s < StreamCount; ++s) {
+		std::vector<Allocation*> live;
+		for (auto& allocation : _allocations) {
+			if (allocation.Ranges[s]) { live.push_back(&allocation); }
+		}
+		std::sort(live.begin(), live.end(), [s](const Allocation* a, const Allocation* b) {
+			return a->Offsets[s] < b->Offsets[s];
+		});
+
+		_allocators[s].Reset();
+		for (auto* allocation : live) {
+			const auto from        = allocation->Offsets[s];
+			allocation->Ranges[s]  = _allocators[s].Allocate(allocation->Counts[s]);
+			allocation->Offsets[s] = allocation->Ranges[s].Offset;
+			if (allocation->Offsets[s] == from) { continue; }
+
+			const auto AddMove = [&](Vulkan::Buffer& buffer, vk::DeviceSize elementSize) {
+				const auto size = allocation->Counts[s] * elementSize;
+				moves.push_back({&buffer, from * elementSize, allocation->Offsets[s] * elementSize, size});
+				scratchSize += size;
+			};
+			switch (Stream(s)) {
+				case Stream::Vertices:
+					AddMove(*_positionBuffer, sizeof(glm::vec3));
+					AddMove(*_vertexBuffer, _vertexStride);
+					break;
+				case Stream::Indices:
+					AddMove(*_indexBuffer, sizeof(uint32_t));
+					break;
+				case Stream::Triangles:
+					AddMove(*_triangleBuffer, sizeof(uint8_t));
+					break;
+				case Stream::Meshlets:
+					AddMove(*_meshletBuffer, sizeof(Meshlet));
+					break;
+				default:
+					break;
+			}
+		}
+	}
+	if (moves.empty()) { return false; }
+
+	// Ranges may overlap their own destination, so every move goes through a scratch buffer.
+	auto scratch = device.CreateBuffer(Vulkan::BufferCreateInfo(Vulkan::BufferDomain::Device, scratchSize));
+	auto cmd     = device.RequestCommandBuffer(Vulkan::CommandBufferType::Generic, "Geometry Defragment");
+
+	vk::DeviceSize scratchOffset = 0;
+	for (const auto& move : moves) {
+		cmd->CopyBuffer(*scratch, *move.Buffer, {vk::BufferCopy(move.From, scratchOffset, move.Size)});
+		scratchOffset += move.Size;
+	}
+	const vk::MemoryBarrier2 barrier(vk::PipelineStageFlagBits2::eTransfer,
+	                                 vk::AccessFlagBits2::eTransferRead | vk::AccessFlagBits2::eTransferWrite,
+	                                 vk::PipelineStageFlagBits2::eTransfer,
+	                                 vk::AccessFlagBits2::eTransferRead | vk::AccessFlagBits2::eTransferWrite);
+	cmd->Barrier(vk::DependencyInfo({}, barrier, nullptr, nullptr));
+	scratchOffset = 0;
+	for (const auto& move : moves) {
+		cmd->CopyBuffer(*move.Buffer, *scratch, {vk::BufferCopy(scratchOffset, move.To, move.Size)});
+		scratchOffset += move.Size;
+	}
+
+	device.Submit(cmd);
+	device.WaitIdle();
+	++_generation;
+
+	return true;
+}
+}  // namespace Luna
@@ -0,0 +1,261 @@
+#include <Luna/Renderer/OcclusionBuffer.hpp>
+
+// The AVX2 paths are compiled on every x86 target, whatever the compiler targets by default, and only taken once the
+// CPU is known to support them.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#	define LUNA_OCCLUSION_AVX2
+#	include <immintrin.h>
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#		define LUNA_TARGET_AVX2
+#	else
+#		define LUNA_TARGET_AVX2 __attribute__((target("avx2")))
+#	endif
+#endif
+
+namespace Luna {
+static_assert(OcclusionBuffer::Width % 8 == 0, "Occlusion buffer rows must be a whole number of 8-pixel spans");
+
+/** A range of pixels, with exclusive ends. */
+struct PixelRect {
+	int XStart;
+	int XEnd;
+	int YStart;
+	int YEnd;
+};
+
+/** A triangle ready to be rasterized: its inner-coverage edge functions and its conservative depth plane. */
+struct RasterTriangle {
+	std::array<glm::vec3, 3> Edges; /** A, B and C of each edge function E(x, y) = A * x + B * y + C. */
+	float DepthX;                   /** Depth change per pixel along x. */
+	float DepthY;                   /** Depth change per pixel along y. */
+	float DepthOrigin;              /** Depth at the origin, already biased towards the far side of each pixel. */
+	float DepthMin;                 /** The triangle's farthest vertex depth, which no pixel goes below. */
+	PixelRect Bounds;
+};
+
+static void RasterizeScalar(const RasterTriangle& triangle, float* depth) {
+	for (int y = triangle.Bounds.YStart; y < triangle.Bounds.YEnd; ++y) {
+		const float centerY = float(y) + 0.5f;
+		float* row          = depth + y * OcclusionBuffer::Width;
+		for (int x = triangle.Bounds.XStart; x < triangle.Bounds.XEnd; ++x) {
+			const float centerX = float(x) + 0.5f;
+			const bool inside   = std::ranges::all_of(triangle.Edges, [&](const glm::vec3& edge) {
+				return edge.x * centerX + edge.y * centerY + edge.z >= 0.0f;
+			});
+			if (!inside) { continue; }
+
+			const float pixelDepth = triangle.DepthOrigin + triangle.DepthX * centerX + triangle.DepthY * centerY;
+			row[x]                 = std::max(row[x], std::max(pixelDepth, triangle.DepthMin));
+		}
+	}
+}
+
+static bool IsVisibleScalar(const float* depth, const PixelRect& rect, float nearest) {
+	for (int y = rect.YStart; y < rect.YEnd; ++y) {
+		const float* row = depth + y * OcclusionBuffer::Width;
+		for (int x = rect.XStart; x < rect.XEnd; ++x) {
+			if (row[x] <= nearest) { return true; }
+		}
+	}
+
+	return false;
+}
+
+#ifdef LUNA_OCCLUSION_AVX2
+static bool HasAVX2() {
+#	ifdef _MSC_VER
+	int info[4];
+	::__cpuid(info, 0);
+	if (info[0] < 7) { return false; }
+
+	// The OS has to save the upper halves of the vector registers too, or using them corrupts other threads' state.
+	::__cpuid(info, 1);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx     = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (::_xgetbv(0) & 0x6) != 0x6) { return false; }
+
+	::__cpuidex(info, 7, 0);
+
+	return (info[1] & (1 << 5)) != 0;
+#	else
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports("avx2");
+#	endif
+}
+
+static bool UseAVX2() {
+	static const bool supported = HasAVX2();
+
+	return supported;
+}
+
+LUNA_TARGET_AVX2 static void RasterizeAVX2(const RasterTriangle& triangle, float* depth) {
+	const __m256 laneX    = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+	const __m256 zero     = _mm256_setzero_ps();
+	const __m256 depthX   = _mm256_set1_ps(triangle.DepthX);
+	const __m256 depthMin = _mm256_set1_ps(triangle.DepthMin);
+	__m256 edgeX[3];
+	for (uint32_t e = 0; e < 3; ++e) { edgeX[e] = _mm256_set1_ps(triangle.Edges[e].x); }
+
+	for (int y = triangle.Bounds.YStart; y < triangle.Bounds.YEnd; ++y) {
+		const float centerY = float(y) + 0.5f;
+		float* row          = depth + y * OcclusionBuffer::Width;
+
+		__m256 edgeRow[3];
+		for (uint32_t e = 0; e < 3; ++e) {
+			edgeRow[e] = _mm256_set1_ps(triangle.Edges[e].y * centerY + triangle.Edges[e].z);
+		}
+		const __m256 depthRow = _mm256_set1_ps(triangle.DepthOrigin + triangle.DepthY * centerY);
+
+		for (int x = triangle.Bounds.XStart & ~7; x < triangle.Bounds.XEnd; x += 8) {
+			const __m256 centerX = _mm256_add_ps(_mm256_set1_ps(float(x)), laneX);
+			__m256 inside        = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (uint32_t e = 0; e < 3; ++e) {
+				const __m256 edge = _mm256_add_ps(_mm256_mul_ps(edgeX[e], centerX), edgeRow[e]);
+				inside            = _mm256_and_ps(inside, _mm256_cmp_ps(edge, zero, _CMP_GE_OQ));
+			}
+			if (_mm256_movemask_ps(inside) == 0) { continue; }
+
+			const __m256 pixelDepth = _mm256_max_ps(_mm256_add_ps(_mm256_mul_ps(depthX, centerX), depthRow), depthMin);
+			const __m256 current    = _mm256_loadu_ps(row + x);
+			_mm256_storeu_ps(row + x, _mm256_blendv_ps(current, _mm256_max_ps(current, pixelDepth), inside));
+		}
+	}
+}
+
+LUNA_TARGET_AVX2 static bool IsVisibleAVX2(const float* depth, const PixelRect& rect, float nearest) {
+	const __m256 laneX   = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+	const __m256 minX    = _mm256_set1_ps(float(rect.XStart));
+	const __m256 maxX    = _mm256_set1_ps(float(rect.XEnd));
+	const __m256 boxNear = _mm256_set1_ps(nearest);
+	for (int y = rect.YStart; y < rect.YEnd; ++y) {
+		const float* row = depth + y * OcclusionBuffer::Width;
+		for (int x = rect.XStart & ~7; x < rect.XEnd; x += 8) {
+			const __m256 pixelX = _mm256_add_ps(_mm256_set1_ps(float(x)), laneX);
+			const __m256 inBox  = _mm256_and_ps(_mm256_cmp_ps(pixelX, minX, _CMP_GE_OQ),
+			                                    _mm256_cmp_ps(pixelX, maxX, _CMP_LT_OQ));
+			const __m256 open   = _mm256_cmp_ps(_mm256_loadu_ps(row + x), boxNear, _CMP_LE_OQ);
+			if (_mm256_movemask_ps(_mm256_and_ps(inBox, open)) != 0) { return true; }
+		}
+	}
+
+	return false;
+}
+#endif
+
+OcclusionBuffer::OcclusionBuffer() : _depth(Width * Height, 0.0f) {}
+
+void OcclusionBuffer::Begin(const glm::mat4& viewProjection) {
+	_viewProjection = viewProjection;
+	std::ranges::fill(_depth, 0.0f);
+}
+
+void OcclusionBuffer::RenderOccluder(std::span<const glm::vec3> triangles, const glm::mat4& transform) {
+	const glm::mat4 toClip = _viewProjection * transform;
+	for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+		const std::array<glm::vec4, 3> clip = {toClip * glm::vec4(triangles[i], 1.0f),
+		                                       toClip * glm::vec4(triangles[i + 1], 1.0f),
+		                                       toClip * glm::vec4(triangles[i + 2], 1.0f)};
+
+		// Reversed-Z puts the near plane at z = w, and there is no far plane. Triangles crossing the near plane are cut
+		// against it, leaving a triangle or a quad.
+		std::array<glm::vec4, 4> polygon;
+		uint32_t vertexCount = 0;
+		for (uint32_t v = 0; v < 3; ++v) {
+			const auto& a  = clip[v];
+			const auto& b  = clip[(v + 1) % 3];
+			const float da = a.w - a.z;
+			const float db = b.w - b.z;
+			if (da >= 0.0f) { polygon[vertexCount++] = a; }
+			if ((da >= 0.0f) != (db >= 0.0f)) { polygon[vertexCount++] = a + (b - a) * (da / (da - db)); }
+		}
+		for (uint32_t v = 2; v < vertexCount; ++v) { RasterizeTriangle(polygon[0], polygon[v - 1], polygon[v]); }
+	}
+}
+
+void OcclusionBuffer::RasterizeTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2) {
+	const auto ToScreen = [](const glm::vec4& v) {
+		const float invW = 1.0f / v.w;
+
+		return glm::vec3((v.x * invW * 0.5f + 0.5f) * Width, (v.y * invW * 0.5f + 0.5f) * Height, v.z * invW);
+	};
+	const glm::vec3 p0 = ToScreen(v0);
+	glm::vec3 p1       = ToScreen(v1);
+	glm::vec3 p2       = ToScreen(v2);
+
+	// Occluders are drawn from both sides, so clockwise triangles are flipped rather than culled.
+	float area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+	if (std::abs(area) < 1e-6f) { return; }
+	if (area < 0.0f) {
+		std::swap(p1, p2);
+		area = -area;
+	}
+
+	RasterTriangle triangle;
+	triangle.Bounds = {int(std::max(0.0f, std::floor(std::min({p0.x, p1.x, p2.x})))),
+	                   int(std::min(float(Width), std::ceil(std::max({p0.x, p1.x, p2.x})))),
+	                   int(std::max(0.0f, std::floor(std::min({p0.y, p1.y, p2.y})))),
+	                   int(std::min(float(Height), std::ceil(std::max({p0.y, p1.y, p2.y}))))};
+	if (triangle.Bounds.XStart >= triangle.Bounds.XEnd || triangle.Bounds.YStart >= triangle.Bounds.YEnd) { return; }
+
+	// Edge functions, positive inside the triangle. Only pixels which the triangle covers entirely are written, so each
+	// C is pulled in by the most E can vary between a pixel's center and its corners.
+	triangle.Edges = {glm::vec3(p0.y - p1.y, p1.x - p0.x, p0.x * p1.y - p0.y * p1.x),
+	                  glm::vec3(p1.y - p2.y, p2.x - p1.x, p1.x * p2.y - p1.y * p2.x),
+	                  glm::vec3(p2.y - p0.y, p0.x - p2.x, p2.x * p0.y - p2.y * p0.x)};
+	for (auto& edge : triangle.Edges) { edge.z -= 0.5f * (std::abs(edge.x) + std::abs(edge.y)); }
+
+	// Depth is linear in screen space. Each pixel takes the smallest (farthest) depth the plane reaches inside it, but
+	// never less than the triangle's farthest vertex.
+	triangle.DepthX      = ((p1.z - p0.z) * (p2.y - p0.y) - (p2.z - p0.z) * (p1.y - p0.y)) / area;
+	triangle.DepthY      = ((p2.z - p0.z) * (p1.x - p0.x) - (p1.z - p0.z) * (p2.x - p0.x)) / area;
+	const float zBias    = 0.5f * (std::abs(triangle.DepthX) + std::abs(triangle.DepthY));
+	triangle.DepthMin    = std::min({p0.z, p1.z, p2.z});
+	triangle.DepthOrigin = p0.z - triangle.DepthX * p0.x - triangle.DepthY * p0.y - zBias;
+
+#ifdef LUNA_OCCLUSION_AVX2
+	if (UseAVX2()) {
+		RasterizeAVX2(triangle, _depth.data());
+		return;
+	}
+#endif
+	RasterizeScalar(triangle, _depth.data());
+}
+
+bool OcclusionBuffer::IsVisible(const BvhBounds& bounds) const {
+	if (bounds.Empty()) { return false; }
+
+	glm::vec2 screenMin(std::numeric_limits<float>::max());
+	glm::vec2 screenMax(std::numeric_limits<float>::lowest());
+	float nearest = 0.0f;
+	for (uint32_t i = 0; i < 8; ++i) {
+		const glm::vec3 corner((i & 1) ? bounds.Max.x : bounds.Min.x,
+		                       (i & 2) ? bounds.Max.y : bounds.Min.y,
+		                       (i & 4) ? bounds.Max.z : bounds.Min.z);
+		const glm::vec4 clip = _viewProjection * glm::vec4(corner, 1.0f);
+		// A box which reaches the near plane may cover any part of the screen.
+		if (clip.z > clip.w) { return true; }
+
+		const float invW = 1.0f / clip.w;
+		const glm::vec2 screen((clip.x * invW * 0.5f + 0.5f) * Width, (clip.y * invW * 0.5f + 0.5f) * Height);
+		screenMin = glm::min(screenMin, screen);
+		screenMax = glm::max(screenMax, screen);
+		nearest   = std::max(nearest, clip.z * invW);
+	}
+
+	const PixelRect rect = {int(std::max(0.0f, std::floor(screenMin.x))),
+	                        int(std::min(float(Width), std::ceil(screenMax.x))),
+	                        int(std::max(0.0f, std::floor(screenMin.y))),
+	                        int(std::min(float(Height), std::ceil(screenMax.y)))};
+	if (rect.XStart >= rect.XEnd || rect.YStart >= rect.YEnd) { return false; }
+
+	// The box is visible wherever no occluder is nearer than the box's nearest point.
+#ifdef LUNA_OCCLUSION_AVX2
+	if (UseAVX2()) { return IsVisibleAVX2(_depth.data(), rect, nearest); }
+#endif
+
+	return IsVisibleScalar(_depth.data(), rect, nearest);
+}
+}  // namespace Luna
@@ -302,7 +302,7 @@ void RenderGraph::Log() {
 					"RenderGraph", "    - Depth/Stencil Read: {}", Resource(pass.GetDepthStencilInput()->GetPhysicalIndex()));
 			}
 
-			const auto Attachments = [&](const std::string& type, const std::vector<RenderTextureResource*>& attachments) {
+			const auto Attachments = [&](const std::string& type, const RenderPass::TextureList& attachments) {
 				for (size_t att = 0; att < attachments.size(); ++att) {
 					Log::Debug("RenderGraph", "    - {} #{}: {}", type, att, Resource(attachments[att]->GetPhysicalIndex()));
 				}
@@ -880,7 +880,7 @@ void RenderGraph::BuildPhysicalPasses() {
 
 	PhysicalPass physicalPass;
 
-	const auto FindAttachment = [](const std::vector<RenderTextureResource*>& resourceList,
+	const auto FindAttachment = [](const RenderPass::TextureList& resourceList,
 	                               const RenderTextureResource* resource) -> bool {
 		if (!resource) { return false; }
 
@@ -890,8 +890,7 @@ void RenderGraph::BuildPhysicalPasses() {
 
 		return it != resourceList.end();
 	};
-	const auto FindBuffer = [](const std::vector<RenderBufferResource*>& resourceList,
-	                           const RenderBufferResource* resource) -> bool {
+	const auto FindBuffer = [](const RenderPass::BufferList& resourceList, const RenderBufferResource* resource) -> bool {
 		if (!resource) { return false; }
 
 		auto it = std::find_if(resourceList.begin(), resourceList.end(), [resource](const RenderBufferResource* res) {
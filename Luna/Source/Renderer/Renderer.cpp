@@ -6,6 +6,8 @@
 #include <Luna/Core/Window.hpp>
 #include <Luna/Core/WindowManager.hpp>
 #include <Luna/Renderer/Camera.hpp>
+#include <Luna/Renderer/GeometryArena.hpp>
+#include <Luna/Renderer/OcclusionBuffer.hpp>
 #include <Luna/Renderer/Renderer.hpp>
 #include <Luna/Renderer/Scene.hpp>
 #include <Luna/Renderer/ShaderManager.hpp>
@@ -27,11 +29,20 @@ constexpr static unsigned int MaxMeshletsPerBatch  = 65'536;
 constexpr static unsigned int MaxMeshletBatches    = MaxMeshlets / MaxMeshletsPerBatch;
 constexpr static unsigned int MaxTrianglesPerBatch = MaxMeshletsPerBatch * 64;
 constexpr static unsigned int MaxIndicesPerBatch   = MaxTrianglesPerBatch * 3;
+// Elements of each stream the geometry arena holds, shared by every loaded model.
+constexpr static GeometryArena::StreamSizes GeometryArenaCapacities = {8 * 1024 * 1024,   // Vertices
+                                                                       32 * 1024 * 1024,  // Indices
+                                                                       64 * 1024 * 1024,  // Triangles
+                                                                       512 * 1024};       // Meshlets
+// Vertex format of the geometry arena. Every model the renderer loads is imported in it.
+constexpr static VertexFormat GeometryVertexFormat = VertexFormat::Quantized;
 
 enum class CullFlagBits : uint32_t {
 	MeshletFrustum   = 1 << 0,
 	MeshletHiZ       = 1 << 1,
 	TriangleBackface = 1 << 2,
+	MeshletBackface  = 1 << 3,
+	MeshletLod       = 1 << 4,
 };
 template <>
 struct EnableBitmaskOperators<CullFlagBits> : std::true_type {};
@@ -71,6 +82,8 @@ struct ComputeUniforms {
 	uint32_t MeshletCount     = 0;
 	uint32_t MeshletsPerBatch = MaxMeshletsPerBatch;
 	uint32_t IndicesPerBatch  = 0;
+	float LodErrorThreshold   = 1.0f;
+	uint32_t InstanceCount    = 0;
 };
 
 struct VisbufferStats {
@@ -94,6 +107,8 @@ struct RenderResources {
 		DepthBuffer.Reset();
 		HiZBuffer.Reset();
 		HiZBufferMips.clear();
+		InstanceBuffer.Reset();
+		TransformBuffer.Reset();
 	}
 
 	Vulkan::BufferHandle VisibleMeshlets;
@@ -104,6 +119,8 @@ struct RenderResources {
 	Vulkan::ImageHandle DepthBuffer;
 	Vulkan::ImageHandle HiZBuffer;
 	std::vector<Vulkan::ImageViewHandle> HiZBufferMips;
+	Vulkan::BufferHandle InstanceBuffer;
+	Vulkan::BufferHandle TransformBuffer;
 
 	ShaderProgramVariant* CullMeshlets  = nullptr;
 	ShaderProgramVariant* CullTriangles = nullptr;
@@ -121,14 +138,16 @@ static struct RendererState {
 	EditorCamera Camera;
 	bool CameraActive            = false;
 	glm::dvec2 LastMousePosition = glm::dvec2(0);
+	std::unique_ptr<GeometryArena> Geometry;
 	Scene Scene;
+	SceneLoadHandle SceneLoad;
 	RenderScene RenderScene;
+	OcclusionBuffer Occlusion;
 	ShaderProgramVariant* Program;
 
 	PerFrameBuffer SceneBuffer;
 	PerFrameBuffer ComputeUniforms;
-	PerFrameBuffer MeshletBuffer;
-	PerFrameBuffer TransformBuffer;
+	PerFrameBuffer SceneUploadBuffer;
 	PerFrameBuffer DebugLinesBuffer;
 	PerFrameBuffer VisBufferStatsBuffer;
 	RenderResources Resources;
@@ -140,9 +159,16 @@ static struct RendererState {
 	bool FreezeCullFrustum = false;
 	bool ShowCullFrustum   = false;
 
-	bool CullMeshletsFrustum   = true;
-	bool CullMeshletsHiZ       = true;
-	bool CullTrianglesBackface = true;
+	bool CullInstancesOcclusion = false;
+	bool CullMeshletsBackface   = true;
+	bool CullMeshletsFrustum    = true;
+	bool CullMeshletsHiZ        = true;
+	bool CullTrianglesBackface  = true;
+
+	bool MeshLods           = true;
+	float LodErrorThreshold = 1.0f;
+
+	uint32_t DroppedMeshlets = 0;
 } State;
 
 static void DrawDebugLine(const glm::vec3& start, const glm::vec3& end, const glm::vec3& color = glm::vec3(1)) {
@@ -155,29 +181,55 @@ static void RendererUI() {
 
 	if (ImGui::Begin("Model")) {
 		ImGui::TableNextColumn();
+		if (State.SceneLoad) {
+			const auto loadState = State.SceneLoad->State.load();
+			if (loadState == SceneLoad::LoadState::Reading) {
+				ImGui::Text("Loading model...");
+			} else if (loadState == SceneLoad::LoadState::Uploading) {
+				ImGui::Text("Uploading meshes: %u / %u",
+				            State.SceneLoad->ResidentMeshes.load(),
+				            State.SceneLoad->MeshCount.load());
+				ImGui::Text("Uploading textures: %u / %u",
+				            State.SceneLoad->ResidentTextures.load(),
+				            State.SceneLoad->TextureCount.load());
+			}
+		}
+
 		ImGui::Checkbox("Freeze Culling Frustum", &State.FreezeCullFrustum);
 		ImGui::Checkbox("Show Culling Frustum", &State.ShowCullFrustum);
 
 		ImGui::Spacing();
 
+		ImGui::Checkbox("Instance Occlusion Cull (CPU)", &State.CullInstancesOcclusion);
+		ImGui::Checkbox("Meshlet Backface Cull", &State.CullMeshletsBackface);
 		ImGui::Checkbox("Meshlet Frustum Cull", &State.CullMeshletsFrustum);
 		ImGui::Checkbox("Meshlet Occlusion Cull", &State.CullMeshletsHiZ);
 		ImGui::Checkbox("Triangle Backface Cull", &State.CullTrianglesBackface);
 
+		ImGui::Spacing();
+
+		ImGui::Checkbox("Mesh LODs", &State.MeshLods);
+		ImGui::SliderFloat("LOD Error (px)", &State.LodErrorThreshold, 0.0f, 16.0f);
+
 		const double visibleMeshlets(stats->VisibleMeshlets);
-		const double totalMeshlets(State.RenderScene.Meshlets.size());
+		const double totalMeshlets(State.RenderScene.MeshletCount);
 		const double culledMeshletsPct = std::floor((1.0 - (visibleMeshlets / totalMeshlets)) * 100.0);
 		const double visibleTriangles(stats->VisibleTriangles);
 		const double totalTriangles(State.RenderScene.TriangleCount);
 		const double culledTrianglesPct = std::floor((1.0 - (visibleTriangles / totalTriangles)) * 100.0);
 		ImGui::Text("Meshlets: %u / %u (%.0f%% culled)",
 		            stats->VisibleMeshlets,
-		            uint32_t(State.RenderScene.Meshlets.size()),
+		            State.RenderScene.MeshletCount,
 		            culledMeshletsPct);
 		ImGui::Text("Triangles: %u / %llu (%.0f%% culled)",
 		            stats->VisibleTriangles,
 		            State.RenderScene.TriangleCount,
 		            culledTrianglesPct);
+		ImGui::Text("Culled Instances (CPU): %u", State.RenderScene.OccludedInstances);
+		const auto& textureStreamer = State.Scene.GetTextureStreamer();
+		ImGui::Text("Texture Memory: %.1f / %.1f MiB",
+		            double(textureStreamer.GetResidentBytes()) / (1024.0 * 1024.0),
+		            double(textureStreamer.GetBudgetBytes()) / (1024.0 * 1024.0));
 
 		ImGui::Spacing();
 
@@ -224,6 +276,67 @@ static void RendererUI() {
 	}
 }
 
+/**
+ * Copy the parts of the RenderScene which changed since the last frame into its persistent GPU buffers. A buffer which
+ * is too small is replaced with a larger one, with room to grow, and uploaded in full.
+ */
+static void UploadRenderScene(Vulkan::CommandBuffer& cmd) {
+	auto& scene = State.RenderScene;
+	auto& res   = State.Resources;
+
+	const auto Reserve = [](Vulkan::BufferHandle& buffer, size_t elementSize, size_t count, auto& dirty) {
+		const vk::DeviceSize size = std::max<vk::DeviceSize>(elementSize * count, elementSize);
+		if (buffer && buffer->GetCreateInfo().Size >= size) { return; }
+
+		const Vulkan::BufferCreateInfo bufferCI(Vulkan::BufferDomain::Device, size + size / 2);
+		buffer = State.Device->CreateBuffer(bufferCI);
+		dirty  = {{0, uint32_t(count)}};
+	};
+	Reserve(res.InstanceBuffer, sizeof(RenderScene::Instance), scene.Instances.size(), scene.DirtyInstances);
+	Reserve(res.TransformBuffer, sizeof(glm::mat4), scene.Transforms.size(), scene.DirtyTransforms);
+
+	vk::DeviceSize uploadSize = 0;
+	for (const auto& range : scene.DirtyInstances) { uploadSize += sizeof(RenderScene::Instance) * range.Count; }
+	for (const auto& range : scene.DirtyTransforms) { uploadSize += sizeof(glm::mat4) * range.Count; }
+	if (uploadSize == 0) { return; }
+
+	auto& uploadBuffer          = State.SceneUploadBuffer.Get(uploadSize);
+	vk::DeviceSize uploadOffset = 0;
+	const auto Stage            = [&](const auto& elements, const auto& ranges) {
+		const vk::DeviceSize elementSize = sizeof(elements[0]);
+		std::vector<vk::BufferCopy> copies;
+		for (const auto& range : ranges) {
+			if (range.Count == 0) { continue; }
+
+			const vk::DeviceSize size = elementSize * range.Count;
+			uploadBuffer.WriteData(&elements[range.Offset], size, uploadOffset);
+			copies.emplace_back(uploadOffset, elementSize * range.Offset, size);
+			uploadOffset += size;
+		}
+
+		return copies;
+	};
+	// The previous frame may still be reading the regions we are about to overwrite.
+	const auto readStages = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eVertexShader;
+	const auto Copy       = [&](const Vulkan::Buffer& buffer, const std::vector<vk::BufferCopy>& copies) {
+		if (copies.empty()) { return; }
+
+		cmd.BufferBarrier(buffer,
+		                  readStages,
+		                  vk::AccessFlagBits2::eNone,
+		                  vk::PipelineStageFlagBits2::eTransfer,
+		                  vk::AccessFlagBits2::eTransferWrite);
+		cmd.CopyBuffer(buffer, uploadBuffer, copies);
+		cmd.BufferBarrier(buffer,
+		                  vk::PipelineStageFlagBits2::eTransfer,
+		                  vk::AccessFlagBits2::eTransferWrite,
+		                  readStages,
+		                  vk::AccessFlagBits2::eShaderStorageRead);
+	};
+	Copy(*res.InstanceBuffer, Stage(scene.Instances, scene.DirtyInstances));
+	Copy(*res.TransformBuffer, Stage(scene.Transforms, scene.DirtyTransforms));
+}
+
 bool Renderer::Initialize() {
 	const auto instanceExtensions                   = WindowManager::GetRequiredInstanceExtensions();
 	const std::vector<const char*> deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
@@ -231,8 +344,10 @@ bool Renderer::Initialize() {
 	State.Context = MakeHandle<Vulkan::Context>(instanceExtensions, deviceExtensions);
 	State.Device  = MakeHandle<Vulkan::Device>(*State.Context);
 
+	State.Geometry = std::make_unique<GeometryArena>(GeometryVertexFormat, GeometryArenaCapacities);
+
 	State.Camera.SetPosition({0, 0, 0.025});
-	State.Scene.LoadModel("res://Models/Bistro.glb");
+	State.SceneLoad = State.Scene.LoadModel("res://Models/Bistro.glb");
 
 	Input::OnKey += [](Key key, InputAction action, InputMods mods) {};
 	Input::OnMouseButton += [](MouseButton button, InputAction action, InputMods mods) {
@@ -257,7 +372,7 @@ bool Renderer::Initialize() {
 
 	auto& res = State.Resources;
 
-	const Vulkan::BufferCreateInfo visibleMeshlets(Vulkan::BufferDomain::Device, MaxMeshlets * sizeof(uint32_t));
+	const Vulkan::BufferCreateInfo visibleMeshlets(Vulkan::BufferDomain::Device, MaxMeshlets * sizeof(glm::uvec2));
 	res.VisibleMeshlets = State.Device->CreateBuffer(visibleMeshlets);
 
 	const Vulkan::BufferCreateInfo cullTriangleDispatch(Vulkan::BufferDomain::Device,
@@ -279,14 +394,15 @@ bool Renderer::Initialize() {
 }
 
 void Renderer::Shutdown() {
+	State.SceneLoad.Reset();
 	State.Scene.Clear();
+	State.Geometry.reset();
 	State.Resources.~RenderResources();
 	State.VisBufferStatsBuffer.Reset();
 	State.SceneBuffer.Reset();
 	State.DebugLinesBuffer.Reset();
 	State.ComputeUniforms.Reset();
-	State.MeshletBuffer.Reset();
-	State.TransformBuffer.Reset();
+	State.SceneUploadBuffer.Reset();
 	State.Device.Reset();
 	State.Context.Reset();
 }
@@ -295,9 +411,14 @@ Vulkan::Device& Renderer::GetDevice() {
 	return *State.Device;
 }
 
+GeometryArena& Renderer::GetGeometryArena() {
+	return *State.Geometry;
+}
+
 void Renderer::Render() {
 	auto& device = *State.Device;
 	device.NextFrame();
+	State.Geometry->BeginFrame();
 
 	if (!Engine::GetMainWindow()) { return; }
 
@@ -358,34 +479,55 @@ void Renderer::Render() {
 		}
 	}
 
-	State.RenderScene     = State.Scene.Flatten();
-	auto& sceneBuffer     = State.SceneBuffer.Get(sizeof(SceneData));
-	auto& meshletBuffer   = State.MeshletBuffer.Get(sizeof(Meshlet) * State.RenderScene.Meshlets.size());
-	auto& transformBuffer = State.TransformBuffer.Get(sizeof(glm::mat4) * State.RenderScene.Transforms.size());
+	const float pixelsPerUnit = State.SceneData.Projection[1][1] * State.SceneData.ViewportExtent.y * 0.5f;
+	State.Scene.RequestTextureMips(State.SceneData.FrustumPlanes, State.Camera.GetPosition(), pixelsPerUnit);
+	if (State.CullInstancesOcclusion) { State.Occlusion.Begin(State.CullFrustum); }
+	State.Scene.Update(State.RenderScene, State.CullInstancesOcclusion ? &State.Occlusion : nullptr);
+	auto& sceneBuffer = State.SceneBuffer.Get(sizeof(SceneData));
 	sceneBuffer.WriteData(&State.SceneData, sizeof(State.SceneData));
-	meshletBuffer.WriteData(State.RenderScene.Meshlets.data(), sizeof(Meshlet) * State.RenderScene.Meshlets.size());
-	transformBuffer.WriteData(State.RenderScene.Transforms.data(),
-	                          sizeof(glm::mat4) * State.RenderScene.Transforms.size());
 
 	if (!State.DebugLines.empty()) {
 		auto& debugLinesBuffer = State.DebugLinesBuffer.Get(sizeof(DebugLine) * State.DebugLines.size());
 		debugLinesBuffer.WriteData(State.DebugLines.data(), sizeof(DebugLine) * State.DebugLines.size());
 	}
 
-	ComputeUniforms compute{.MeshletCount    = uint32_t(State.RenderScene.Meshlets.size()),
-	                        .IndicesPerBatch = MaxIndicesPerBatch};
+	// The culling buffers hold a fixed number of meshlets. Anything past that is not drawn rather than written out of
+	// bounds.
+	const uint32_t meshletCount = std::min<uint32_t>(State.RenderScene.MeshletCount, MaxMeshlets);
+	if (State.RenderScene.MeshletCount - meshletCount != State.DroppedMeshlets) {
+		State.DroppedMeshlets = State.RenderScene.MeshletCount - meshletCount;
+		if (State.DroppedMeshlets > 0) {
+			Log::Warning("Renderer",
+			             "Scene has {} meshlets, only the first {} will be drawn",
+			             State.RenderScene.MeshletCount,
+			             MaxMeshlets);
+		}
+	}
+
+	ComputeUniforms compute{.MeshletCount      = meshletCount,
+	                        .IndicesPerBatch   = MaxIndicesPerBatch,
+	                        .LodErrorThreshold = State.LodErrorThreshold,
+	                        .InstanceCount     = uint32_t(State.RenderScene.Instances.size())};
 	compute.CullingFlags = 0;
+	if (State.CullMeshletsBackface) { compute.CullingFlags |= uint32_t(CullFlagBits::MeshletBackface); }
 	if (State.CullMeshletsFrustum) { compute.CullingFlags |= uint32_t(CullFlagBits::MeshletFrustum); }
 	if (State.CullMeshletsHiZ) { compute.CullingFlags |= uint32_t(CullFlagBits::MeshletHiZ); }
 	if (State.CullTrianglesBackface) { compute.CullingFlags |= uint32_t(CullFlagBits::TriangleBackface); }
+	if (State.MeshLods) { compute.CullingFlags |= uint32_t(CullFlagBits::MeshletLod); }
 	State.ComputeUniforms.Get(sizeof(compute)).WriteData(&compute, sizeof(compute));
 
+	std::vector<std::pair<std::string, int>> vertexDefines;
+	if (State.Geometry->GetVertexFormat() == VertexFormat::Quantized) {
+		vertexDefines.push_back({"QUANTIZED_VERTICES", 1});
+	}
+
 	auto& res = State.Resources;
 	if (!res.CullMeshlets) {
 		res.CullMeshlets = ShaderManager::RegisterCompute("res://Shaders/CullMeshlets.comp.glsl")->RegisterVariant();
 	}
 	if (!res.CullTriangles) {
-		res.CullTriangles = ShaderManager::RegisterCompute("res://Shaders/CullTriangles.comp.glsl")->RegisterVariant();
+		res.CullTriangles =
+			ShaderManager::RegisterCompute("res://Shaders/CullTriangles.comp.glsl")->RegisterVariant(vertexDefines);
 	}
 	if (!res.HzbCopy) {
 		res.HzbCopy = ShaderManager::RegisterCompute("res://Shaders/HzbCopy.comp.glsl")->RegisterVariant();
@@ -449,11 +591,12 @@ void Renderer::Render() {
 
 	State.Program =
 		ShaderManager::RegisterGraphics("res://Shaders/StaticMesh.vert.glsl", "res://Shaders/StaticMesh.frag.glsl")
-			->RegisterVariant();
+			->RegisterVariant(vertexDefines);
 
-	const uint32_t meshletBatches = (State.RenderScene.Meshlets.size() + (MaxMeshletsPerBatch - 1)) / MaxMeshletsPerBatch;
+	const uint32_t meshletBatches = (meshletCount + (MaxMeshletsPerBatch - 1)) / MaxMeshletsPerBatch;
 
 	auto cmd = State.Device->RequestCommandBuffer();
+	UploadRenderScene(*cmd);
 
 	// Compute Prep
 	{
@@ -469,7 +612,7 @@ void Renderer::Render() {
       res.HiZBuffer->GetImage(),
       vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, vk::RemainingMipLevels, 0, 1))};
 		const vk::BufferMemoryBarrier2 bufferInvalidates[] = {
-			vk::BufferMemoryBarrier2(vk::PipelineStageFlagBits2::eComputeShader,
+			vk::BufferMemoryBarrier2(vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eVertexShader,
 		                           vk::AccessFlagBits2::eNone,
 		                           vk::PipelineStageFlagBits2::eComputeShader,
 		                           vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite,
@@ -571,9 +714,10 @@ void Renderer::Render() {
 		// Read-Only
 		cmd->SetUniformBuffer(0, 0, State.SceneBuffer.Get());
 		cmd->SetUniformBuffer(1, 0, State.ComputeUniforms.Get());
-		cmd->SetStorageBuffer(1, 1, State.MeshletBuffer.Get());
-		cmd->SetStorageBuffer(1, 2, State.TransformBuffer.Get());
+		cmd->SetStorageBuffer(1, 1, State.Geometry->GetMeshletBuffer());
+		cmd->SetStorageBuffer(1, 2, *res.TransformBuffer);
 		cmd->SetTexture(1, 3, res.HiZBuffer->GetView(), Vulkan::StockSampler::LinearMin);
+		cmd->SetStorageBuffer(1, 7, *res.InstanceBuffer);
 
 		// Write-Only
 		cmd->SetStorageBuffer(1, 4, *res.VisibleMeshlets);
@@ -586,7 +730,7 @@ void Renderer::Render() {
 		const vk::BufferMemoryBarrier2 flushes[] = {
 			vk::BufferMemoryBarrier2(vk::PipelineStageFlagBits2::eComputeShader,
 		                           vk::AccessFlagBits2::eShaderStorageWrite,
-		                           vk::PipelineStageFlagBits2::eComputeShader,
+		                           vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eVertexShader,
 		                           vk::AccessFlagBits2::eShaderStorageRead,
 		                           vk::QueueFamilyIgnored,
 		                           vk::QueueFamilyIgnored,
@@ -617,12 +761,12 @@ void Renderer::Render() {
 		// Read-Only
 		cmd->SetUniformBuffer(0, 0, State.SceneBuffer.Get());
 		cmd->SetUniformBuffer(1, 0, State.ComputeUniforms.Get());
-		cmd->SetStorageBuffer(1, 1, State.MeshletBuffer.Get());
-		cmd->SetStorageBuffer(1, 2, State.Scene.GetPositionBuffer());
-		cmd->SetStorageBuffer(1, 3, State.Scene.GetVertexBuffer());
-		cmd->SetStorageBuffer(1, 4, State.Scene.GetIndexBuffer());
-		cmd->SetStorageBuffer(1, 5, State.Scene.GetTriangleBuffer());
-		cmd->SetStorageBuffer(1, 6, State.TransformBuffer.Get());
+		cmd->SetStorageBuffer(1, 1, State.Geometry->GetMeshletBuffer());
+		cmd->SetStorageBuffer(1, 2, State.Geometry->GetPositionBuffer());
+		cmd->SetStorageBuffer(1, 3, State.Geometry->GetVertexBuffer());
+		cmd->SetStorageBuffer(1, 4, State.Geometry->GetIndexBuffer());
+		cmd->SetStorageBuffer(1, 5, State.Geometry->GetTriangleBuffer());
+		cmd->SetStorageBuffer(1, 6, *res.TransformBuffer);
 		cmd->SetTexture(1, 7, res.HiZBuffer->GetView(), Vulkan::StockSampler::NearestClamp);
 		cmd->SetStorageBuffer(1, 8, *res.VisibleMeshlets);
 
@@ -714,12 +858,13 @@ void Renderer::Render() {
 		cmd->SetCullMode(vk::CullModeFlagBits::eBack);
 		cmd->SetDepthCompareOp(vk::CompareOp::eGreaterOrEqual);
 		cmd->SetUniformBuffer(0, 0, State.SceneBuffer.Get());
-		cmd->SetStorageBuffer(1, 1, State.MeshletBuffer.Get());
-		cmd->SetStorageBuffer(1, 2, State.Scene.GetPositionBuffer());
-		cmd->SetStorageBuffer(1, 3, State.Scene.GetVertexBuffer());
-		cmd->SetStorageBuffer(1, 4, State.Scene.GetIndexBuffer());
-		cmd->SetStorageBuffer(1, 5, State.Scene.GetTriangleBuffer());
-		cmd->SetStorageBuffer(1, 6, State.TransformBuffer.Get());
+		cmd->SetStorageBuffer(1, 1, State.Geometry->GetMeshletBuffer());
+		cmd->SetStorageBuffer(1, 2, State.Geometry->GetPositionBuffer());
+		cmd->SetStorageBuffer(1, 3, State.Geometry->GetVertexBuffer());
+		cmd->SetStorageBuffer(1, 4, State.Geometry->GetIndexBuffer());
+		cmd->SetStorageBuffer(1, 5, State.Geometry->GetTriangleBuffer());
+		cmd->SetStorageBuffer(1, 6, *res.TransformBuffer);
+		cmd->SetStorageBuffer(1, 7, *res.VisibleMeshlets);
 		cmd->SetIndexBuffer(*res.MeshletIndices, 0, vk::IndexType::eUint32);
 		cmd->DrawIndexedIndirect(*res.DrawIndirect, meshletBatches, 0);
 
@@ -2,13 +2,20 @@
 
 #include <Luna/Core/Filesystem.hpp>
 #include <Luna/Core/Threading.hpp>
+#include <Luna/Renderer/BakedScene.hpp>
+#include <Luna/Renderer/OcclusionBuffer.hpp>
 #include <Luna/Renderer/Renderer.hpp>
 #include <Luna/Renderer/Scene.hpp>
+#include <Luna/Utility/SmallVector.hpp>
+#include <Luna/Utility/Timer.hpp>
 #include <Luna/Vulkan/Buffer.hpp>
+#include <Luna/Vulkan/CommandBuffer.hpp>
 #include <Luna/Vulkan/Device.hpp>
+#include <Luna/Vulkan/Semaphore.hpp>
 #include <fastgltf/parser.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/normal.hpp>
+#include <numeric>
 #include <stack>
 
 namespace Luna {
@@ -101,24 +108,96 @@ struct AccessorType<uint32_t> {
 	constexpr static size_t Count                      = 1;
 };
 
+/**
+ * A view of one glTF buffer's bytes. The bytes are never copied: they are either owned by the parsed asset, or live in
+ * a file mapping which is held here for the duration of the import.
+ */
 struct GltfBuffer {
-	std::vector<uint8_t> Data;
+	std::span<const uint8_t> Data;
+	FileMappingHandle Mapping;
+};
+
+// Primitives are decoded and processed in ranges of at most this many elements, so a single huge primitive is still
+// spread across every worker thread.
+constexpr static size_t DecodeRangeSize  = 256 * 1024;
+constexpr static size_t ProcessRangeSize = 3 * 64 * 1024;
+
+constexpr static size_t MaxMeshletIndices   = 64;
+constexpr static size_t MaxMeshletTriangles = 64;
+
+// Each level of the cluster DAG merges up to ClusterGroupSize neighbouring clusters and simplifies them to
+// ClusterReduction of their triangles. Building stops after MaxClusterLevels, once a single cluster remains, or once
+// no group can be simplified by more than ClusterMinReduction.
+constexpr static size_t ClusterGroupSize   = 8;
+constexpr static size_t MaxClusterLevels   = 16;
+constexpr static float ClusterReduction    = 0.5f;
+constexpr static float ClusterMinReduction = 0.85f;
+constexpr static float ClusterNormalWeight = 0.5f;
+
+// Geometry is streamed to the GPU at most this many bytes per frame, which bounds the cost of a frame during a load.
+constexpr static uint64_t StreamingBudget = 16 * 1024 * 1024;
+
+/** A run of a primitive's triangle list, processed independently of the rest of the primitive. */
+struct GltfPrimitiveRange {
+	size_t First = 0;
+	size_t Count = 0;
+
+	std::vector<glm::vec3> Positions;
+	std::vector<Vertex> Attributes;
+	std::vector<uint32_t> Indices;
+
+	size_t VertexOffset = 0;
+	size_t IndexOffset  = 0;
+};
+
+struct GltfPrimitive {
+	size_t PrimitiveIndex;
+	MeshProcessingSteps Steps;
+	// Whether the primitive can be processed as independent triangle ranges. Indexed primitives which are not unpacked
+	// have to be processed whole, since any index may reference any vertex.
+	bool Splittable;
+	size_t VertexCount;
+	size_t IndexCount;
+
+	std::vector<glm::vec3> Positions;
+	std::vector<Vertex> Attributes;
+	std::vector<uint32_t> Indices;
+
+	std::vector<GltfPrimitiveRange> Ranges;
+};
+
+/** A cluster's place in its mesh's LOD DAG. Errors are mesh-space distances from the full-detail surface. */
+struct GltfClusterLod {
+	glm::vec4 Bounds       = glm::vec4(0.0f);
+	float Error            = 0.0f;
+	glm::vec4 ParentBounds = glm::vec4(0.0f);
+	float ParentError      = std::numeric_limits<float>::max();
 };
 
 struct GltfMesh {
+	std::vector<GltfPrimitive> Primitives;
+
 	std::vector<glm::vec3> Positions;
 	std::vector<Vertex> Attributes;
 	std::vector<uint32_t> Indices;
 
 	std::vector<meshopt_Meshlet> Meshlets;
+	std::vector<GltfClusterLod> MeshletLods;
 	std::vector<uint32_t> MeshletIndices;
 	std::vector<uint8_t> MeshletTriangles;
+
+	// Where this mesh's data begins in the combined scene arrays.
+	size_t VertexOffset   = 0;
+	size_t IndexOffset    = 0;
+	size_t TriangleOffset = 0;
 };
 
 struct GltfContext {
 	Path GltfFile;
 	Path GltfFolder;
+	fastgltf::GltfDataBuffer GltfData;
 	fastgltf::Asset GltfAsset;
+	VertexFormat Format;
 
 	std::vector<GltfBuffer> Buffers;
 	std::vector<Mesh>& Meshes;
@@ -128,15 +207,119 @@ struct GltfContext {
 
 	std::vector<glm::vec3>& Positions;
 	std::vector<Vertex>& Attributes;
+	std::vector<QuantizedVertex>& QuantizedAttributes;
 	std::vector<uint32_t>& Indices;
 	std::vector<uint8_t>& Triangles;
 };
 
+enum class ImportStage : uint32_t {
+	Parse,
+	LoadBuffers,
+	Decode,
+	ProcessPrimitives,
+	AllocateMeshes,
+	MergePrimitives,
+	BuildMeshlets,
+	CombineMeshlets,
+	LoadTextures,
+	PrepareStreaming,
+	BuildMeshBvhs,
+	Count
+};
+constexpr static size_t ImportStageCount = size_t(ImportStage::Count);
+constexpr static std::array<std::string_view, ImportStageCount> ImportStageNames = {"Parse",
+                                                                                   "LoadBuffers",
+                                                                                   "Decode",
+                                                                                   "ProcessPrimitives",
+                                                                                   "AllocateMeshes",
+                                                                                   "MergePrimitives",
+                                                                                   "BuildMeshlets",
+                                                                                   "CombineMeshlets",
+                                                                                   "LoadTextures",
+                                                                                   "PrepareStreaming",
+                                                                                   "BuildMeshBvhs"};
+
+/**
+ * Times the stages of an import from whichever threads run their tasks. A timer made without stats to fill hands tasks
+ * back untouched, so untimed imports pay nothing for it.
+ */
+class ImportTimer {
+ public:
+	explicit ImportTimer(SceneImportStats* stats = nullptr) : _stats(stats), _start(GetCurrentTimeNanoseconds()) {}
+
+	/** Wrap a task so that its run time counts towards the stage. */
+	template <typename F>
+	[[nodiscard]] std::function<void()> Wrap(ImportStage stage, F&& task) {
+		if (!_stats) { return std::forward<F>(task); }
+
+		return [this, stage, task = std::forward<F>(task)]() {
+			const auto start = GetCurrentTimeNanoseconds();
+			task();
+			Record(stage, start, GetCurrentTimeNanoseconds());
+		};
+	}
+	/** Run work on the calling thread, counting it towards the stage. */
+	template <typename F>
+	void Run(ImportStage stage, F&& work) {
+		Wrap(stage, std::forward<F>(work))();
+	}
+
+	/** Write out every stage which ran, in the order they started. */
+	void Report() const {
+		if (!_stats) { return; }
+
+		std::vector<size_t> order;
+		for (size_t i = 0; i < ImportStageCount; ++i) {
+			if (_stages[i].Tasks > 0) { order.push_back(i); }
+		}
+		std::ranges::sort(order, {}, [&](size_t i) { return _stages[i].First.load(); });
+
+		_stats->Stages.clear();
+		for (const auto i : order) {
+			const auto& stage = _stages[i];
+			_stats->Stages.push_back({.Name      = std::string(ImportStageNames[i]),
+			                          .WallTime  = double(stage.Last - stage.First) * 1e-9,
+			                          .BusyTime  = double(stage.Busy) * 1e-9,
+			                          .TaskCount = stage.Tasks});
+		}
+		_stats->WallTime    = double(GetCurrentTimeNanoseconds() - _start) * 1e-9;
+		_stats->ThreadCount = Threading::GetThreadCount();
+	}
+
+ private:
+	struct StageTiming {
+		std::atomic<int64_t> First = std::numeric_limits<int64_t>::max();
+		std::atomic<int64_t> Last  = std::numeric_limits<int64_t>::min();
+		std::atomic<int64_t> Busy  = 0;
+		std::atomic_uint32_t Tasks = 0;
+	};
+
+	void Record(ImportStage stage, int64_t start, int64_t end) {
+		auto& timing  = _stages[size_t(stage)];
+		int64_t first = timing.First.load(std::memory_order_relaxed);
+		while (start < first && !timing.First.compare_exchange_weak(first, start, std::memory_order_relaxed)) {}
+		int64_t last = timing.Last.load(std::memory_order_relaxed);
+		while (end > last && !timing.Last.compare_exchange_weak(last, end, std::memory_order_relaxed)) {}
+		timing.Busy.fetch_add(end - start, std::memory_order_relaxed);
+		timing.Tasks.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	SceneImportStats* _stats;
+	int64_t _start;
+	std::array<StageTiming, ImportStageCount> _stages;
+};
+
+/**
+ * Read the accessor's elements, starting at element "first", into dst. Elements past the end of the accessor are left
+ * untouched, so reading in ranges lets large accessors be decoded by several tasks at once.
+ */
 template <typename Source, typename Destination>
-static std::vector<Destination> ConvertAccessorData(const fastgltf::Asset& gltfAsset,
-                                                    const std::vector<GltfBuffer>& buffers,
-                                                    const fastgltf::Accessor& gltfAccessor,
-                                                    bool vertexAccessor) {
+static void ConvertAccessorData(const fastgltf::Asset& gltfAsset,
+                                const std::vector<GltfBuffer>& buffers,
+                                const fastgltf::Accessor& gltfAccessor,
+                                bool vertexAccessor,
+                                size_t first,
+                                std::span<Destination> dst) {
 	static_assert(AccessorType<Destination>::Count > 0, "Unknown type conversion given to ConvertAccessorData");
 	using D = typename AccessorType<Destination>::UnderlyingT;
 
@@ -148,7 +331,7 @@ static std::vector<Destination> ConvertAccessorData(const fastgltf::Asset& gltfA
 	// Accessors used for vertex data must have each element aligned to 4-byte boundaries.
 	constexpr auto vertexStride = attrStride % 4 == 0 ? attrStride : attrStride + 4 - (attrStride % 4);
 
-	const auto count           = gltfAccessor.count;
+	const auto count           = std::min(dst.size(), gltfAccessor.count > first ? gltfAccessor.count - first : 0);
 	const auto normalized      = gltfAccessor.normalized;
 	const auto& gltfBufferView = gltfAsset.bufferViews[*gltfAccessor.bufferViewIndex];
 	const auto& gltfBytes      = buffers[gltfBufferView.bufferIndex].Data;
@@ -170,27 +353,25 @@ static std::vector<Destination> ConvertAccessorData(const fastgltf::Asset& gltfA
 		}
 	};
 
-	std::vector<Destination> dst(count);
-
 	if constexpr (dstCount == 1) {
-		for (size_t i = 0; i < count; ++i) { dst[i] = static_cast<D>(Get(i, 0)); }
+		for (size_t i = 0; i < count; ++i) { dst[i] = static_cast<D>(Get(first + i, 0)); }
 	} else {
 		for (size_t i = 0; i < count; ++i) {
-			dst[i][0] = static_cast<D>(Get(i, 0));
-			dst[i][1] = static_cast<D>(Get(i, 1));
-			if constexpr (dstCount >= 3) { dst[i][2] = static_cast<D>(Get(i, 2)); }
-			if constexpr (dstCount >= 4) { dst[i][3] = static_cast<D>(Get(i, 3)); }
+			dst[i][0] = static_cast<D>(Get(first + i, 0));
+			dst[i][1] = static_cast<D>(Get(first + i, 1));
+			if constexpr (dstCount >= 3) { dst[i][2] = static_cast<D>(Get(first + i, 2)); }
+			if constexpr (dstCount >= 4) { dst[i][3] = static_cast<D>(Get(first + i, 3)); }
 		}
 	}
-
-	return dst;
 }
 
 template <typename T>
-static std::vector<T> GetAccessorData(const fastgltf::Asset& gltfAsset,
-                                      const std::vector<GltfBuffer>& buffers,
-                                      const fastgltf::Accessor& gltfAccessor,
-                                      bool vertexAccessor = false) {
+static void GetAccessorData(const fastgltf::Asset& gltfAsset,
+                            const std::vector<GltfBuffer>& buffers,
+                            const fastgltf::Accessor& gltfAccessor,
+                            bool vertexAccessor,
+                            size_t first,
+                            std::span<T> dst) {
 	constexpr auto outType          = AccessorType<T>::Type;
 	constexpr auto outComponentType = AccessorType<T>::Component;
 	const auto accessorType         = gltfAccessor.type;
@@ -198,36 +379,30 @@ static std::vector<T> GetAccessorData(const fastgltf::Asset& gltfAsset,
 	if (outType == accessorType) {
 		switch (gltfAccessor.componentType) {
 			case fastgltf::ComponentType::Byte:
-				return ConvertAccessorData<int8_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor);
+				return ConvertAccessorData<int8_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor, first, dst);
 			case fastgltf::ComponentType::UnsignedByte:
-				return ConvertAccessorData<uint8_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor);
+				return ConvertAccessorData<uint8_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor, first, dst);
 			case fastgltf::ComponentType::Short:
-				return ConvertAccessorData<int16_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor);
+				return ConvertAccessorData<int16_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor, first, dst);
 			case fastgltf::ComponentType::UnsignedShort:
-				return ConvertAccessorData<uint16_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor);
+				return ConvertAccessorData<uint16_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor, first, dst);
 			case fastgltf::ComponentType::UnsignedInt:
-				return ConvertAccessorData<uint32_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor);
+				return ConvertAccessorData<uint32_t, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor, first, dst);
 			case fastgltf::ComponentType::Float:
-				return ConvertAccessorData<float, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor);
+				return ConvertAccessorData<float, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor, first, dst);
 			case fastgltf::ComponentType::Double:
-				return ConvertAccessorData<double, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor);
+				return ConvertAccessorData<double, T>(gltfAsset, buffers, gltfAccessor, vertexAccessor, first, dst);
 			default:
 				break;
 		}
 	}
-
-	return {};
 }
 
-template <typename T>
-static std::vector<T> GetAccessorData(const fastgltf::Asset& gltfAsset,
-                                      const std::vector<GltfBuffer>& buffers,
-                                      const fastgltf::Primitive& gltfPrimitive,
-                                      VertexAttributeBits attribute) {
+static const fastgltf::Accessor* FindAccessor(const fastgltf::Asset& gltfAsset,
+                                              const fastgltf::Primitive& gltfPrimitive,
+                                              VertexAttributeBits attribute) {
 	if (attribute == VertexAttributeBits::Index) {
-		if (gltfPrimitive.indicesAccessor.has_value()) {
-			return GetAccessorData<T>(gltfAsset, buffers, gltfAsset.accessors[*gltfPrimitive.indicesAccessor]);
-		}
+		if (gltfPrimitive.indicesAccessor.has_value()) { return &gltfAsset.accessors[*gltfPrimitive.indicesAccessor]; }
 	} else {
 		const auto FindAttribute = [&](const char* attributeName) ->
 			typename decltype(gltfPrimitive.attributes)::const_iterator {
@@ -269,12 +444,22 @@ static std::vector<T> GetAccessorData(const fastgltf::Asset& gltfAsset,
 				break;
 		}
 
-		if (it != gltfPrimitive.attributes.end()) {
-			return GetAccessorData<T>(gltfAsset, buffers, gltfAsset.accessors[it->second], true);
-		}
+		if (it != gltfPrimitive.attributes.end()) { return &gltfAsset.accessors[it->second]; }
 	}
 
-	return {};
+	return nullptr;
+}
+
+template <typename T>
+static void GetAccessorData(const fastgltf::Asset& gltfAsset,
+                            const std::vector<GltfBuffer>& buffers,
+                            const fastgltf::Primitive& gltfPrimitive,
+                            VertexAttributeBits attribute,
+                            size_t first,
+                            std::span<T> dst) {
+	if (const auto* gltfAccessor = FindAccessor(gltfAsset, gltfPrimitive, attribute)) {
+		GetAccessorData<T>(gltfAsset, buffers, *gltfAccessor, attribute != VertexAttributeBits::Index, first, dst);
+	}
 }
 
 static VertexAttributes GetAvailableAttributes(const fastgltf::Primitive& prim) {
@@ -318,175 +503,387 @@ static MeshProcessingSteps GetProcessingSteps(VertexAttributes attributes) {
 	return steps;
 }
 
+static bool ParseGltfFile(const Path& gltfFile, fastgltf::GltfDataBuffer& gltfData, fastgltf::Asset& gltfAsset) {
+	fastgltf::Parser parser(fastgltf::Extensions::KHR_texture_basisu);
+
+	// Load glTF/glb file. The parser requires padded input, so the file is copied once. The GLB binary chunk is then
+	// referenced in place by the asset rather than copied again, so this buffer must outlive the import.
+	{
+		auto file = Filesystem::OpenReadOnlyMapping(gltfFile);
+		if (!file) {
+			Log::Error("Renderer", "Failed to open glTF '{}'", gltfFile);
+			return false;
+		}
+		gltfData.copyBytes(file->Data<uint8_t>(), file->GetSize());
+	}
+
+	// Parse file into glTF asset.
+	const auto gltfFileType = fastgltf::determineGltfFileType(&gltfData);
+	if (gltfFileType == fastgltf::GltfType::glTF) {
+		auto asset = parser.loadGLTF(&gltfData, "", fastgltf::Options::None);
+		if (asset.error() != fastgltf::Error::None) {
+			Log::Error("Renderer", "Failed to load glTF: {}", fastgltf::getErrorMessage(asset.error()));
+			return false;
+		}
+		gltfAsset = std::move(asset.get());
+	} else {
+		auto asset = parser.loadBinaryGLTF(&gltfData, "", fastgltf::Options::None);
+		if (asset.error() != fastgltf::Error::None) {
+			Log::Error("Renderer", "Failed to load glb: {}", fastgltf::getErrorMessage(asset.error()));
+			return false;
+		}
+		gltfAsset = std::move(asset.get());
+	}
+
+	return true;
+}
+
 static void LoadBuffer(GltfContext& context, size_t bufferIndex) {
 	const auto& gltfBuffer = context.GltfAsset.buffers[bufferIndex];
 	auto& buffer           = context.Buffers[bufferIndex];
 	std::visit(Overloaded{[](auto& arg) {},
 	                      [&](const fastgltf::sources::Vector& vector) { buffer.Data = vector.bytes; },
 	                      [&](const fastgltf::sources::ByteView& byteView) {
-													buffer.Data = std::vector<uint8_t>(
-														reinterpret_cast<const uint8_t*>(byteView.bytes.data()),
-														reinterpret_cast<const uint8_t*>(byteView.bytes.data() + byteView.bytes.size()));
+													const auto* bytes = reinterpret_cast<const uint8_t*>(byteView.bytes.data());
+													buffer.Data       = {bytes, byteView.bytes.size()};
 												},
 	                      [&](const fastgltf::sources::URI& uri) {
 													const Path path = context.GltfFolder / Path(uri.uri.string());
 													auto map        = Filesystem::OpenReadOnlyMapping(path);
-													if (!map) { return; }
-													const uint8_t* dataStart = map->Data<uint8_t>() + uri.fileByteOffset;
-													buffer.Data              = {dataStart, dataStart + gltfBuffer.byteLength};
+													if (!map || uri.fileByteOffset + gltfBuffer.byteLength > map->GetSize()) { return; }
+													buffer.Data    = {map->Data<uint8_t>() + uri.fileByteOffset, gltfBuffer.byteLength};
+													buffer.Mapping = std::move(map);
 												}},
 	           gltfBuffer.data);
 }
 
-static void LoadMesh(GltfContext& context, size_t meshIndex) {
+static bool IsKtx2Image(const fastgltf::Image& gltfImage) {
+	if (const auto* uri = std::get_if<fastgltf::sources::URI>(&gltfImage.data)) {
+		return uri->mimeType == fastgltf::MimeType::KTX2 || Path(uri->uri.string()).Extension() == ".ktx2";
+	}
+	if (const auto* view = std::get_if<fastgltf::sources::BufferView>(&gltfImage.data)) {
+		return view->mimeType == fastgltf::MimeType::KTX2;
+	}
+	if (const auto* vector = std::get_if<fastgltf::sources::Vector>(&gltfImage.data)) {
+		return vector->mimeType == fastgltf::MimeType::KTX2;
+	}
+	if (const auto* byteView = std::get_if<fastgltf::sources::ByteView>(&gltfImage.data)) {
+		return byteView->mimeType == fastgltf::MimeType::KTX2;
+	}
+
+	return false;
+}
+
+/** The bytes of a buffer or image source, mapping the file which holds them if they are not part of the asset. */
+static std::span<const uint8_t> GetSourceBytes(const fastgltf::DataSource& source,
+                                               const Path& gltfFolder,
+                                               FileMappingHandle& mapping) {
+	if (const auto* vector = std::get_if<fastgltf::sources::Vector>(&source)) { return vector->bytes; }
+	if (const auto* byteView = std::get_if<fastgltf::sources::ByteView>(&source)) {
+		return {reinterpret_cast<const uint8_t*>(byteView->bytes.data()), byteView->bytes.size()};
+	}
+	if (const auto* uri = std::get_if<fastgltf::sources::URI>(&source)) {
+		mapping = Filesystem::OpenReadOnlyMapping(gltfFolder / Path(uri->uri.string()));
+		if (!mapping || uri->fileByteOffset > mapping->GetSize()) { return {}; }
+
+		return {mapping->Data<uint8_t>() + uri->fileByteOffset, mapping->GetSize() - uri->fileByteOffset};
+	}
+
+	return {};
+}
+
+/**
+ * Read and transcode one KTX2 image. Images are read straight from their file or buffer, so this does not wait for the
+ * mesh pipeline's buffers to load.
+ */
+static void LoadGltfTexture(const fastgltf::Asset& gltfAsset,
+                            const Path& gltfFolder,
+                            TextureTarget target,
+                            size_t imageIndex,
+                            TextureData& texture) {
+	const auto& gltfImage = gltfAsset.images[imageIndex];
+	FileMappingHandle mapping;
+	std::span<const uint8_t> bytes;
+	if (const auto* view = std::get_if<fastgltf::sources::BufferView>(&gltfImage.data)) {
+		const auto& bufferView = gltfAsset.bufferViews[view->bufferViewIndex];
+		const auto buffer      = GetSourceBytes(gltfAsset.buffers[bufferView.bufferIndex].data, gltfFolder, mapping);
+		if (bufferView.byteOffset + bufferView.byteLength <= buffer.size()) {
+			bytes = buffer.subspan(bufferView.byteOffset, bufferView.byteLength);
+		}
+	} else {
+		bytes = GetSourceBytes(gltfImage.data, gltfFolder, mapping);
+	}
+
+	const auto name = std::format("glTF image {}", imageIndex);
+	if (bytes.empty()) {
+		Log::Error("Renderer", "Failed to read texture '{}'", name);
+		return;
+	}
+	if (auto loaded = LoadKtx2(bytes, target, name)) { texture = std::move(*loaded); }
+}
+
+/** Read every KTX2 image of the asset on worker threads, by image index. Other images are left empty. */
+static void EnqueueTextureLoads(const fastgltf::Asset& gltfAsset,
+                                const Path& gltfFolder,
+                                TextureTarget target,
+                                std::vector<TextureData>& textures,
+                                TaskGroup& group,
+                                ImportTimer& timer) {
+	textures.resize(gltfAsset.images.size());
+	size_t skipped = 0;
+	for (size_t i = 0; i < gltfAsset.images.size(); ++i) {
+		if (!IsKtx2Image(gltfAsset.images[i])) {
+			++skipped;
+			continue;
+		}
+		group.Enqueue(timer.Wrap(ImportStage::LoadTextures, [&gltfAsset, &gltfFolder, target, &textures, i]() {
+			LoadGltfTexture(gltfAsset, gltfFolder, target, i, textures[i]);
+		}));
+	}
+	if (skipped > 0) { Log::Warning("Renderer", "{} glTF images are not KTX2 and were skipped", skipped); }
+}
+
+/** Record which images each mesh's materials sample, so texture detail can be requested per instance. */
+static void AssignMeshTextures(const fastgltf::Asset& gltfAsset, std::vector<Mesh>& meshes) {
+	const auto GetImage = [&](size_t textureIndex) -> std::optional<uint32_t> {
+		if (textureIndex >= gltfAsset.textures.size()) { return std::nullopt; }
+		const auto& gltfTexture = gltfAsset.textures[textureIndex];
+		if (gltfTexture.basisuImageIndex.has_value()) { return uint32_t(*gltfTexture.basisuImageIndex); }
+		if (gltfTexture.imageIndex.has_value()) { return uint32_t(*gltfTexture.imageIndex); }
+
+		return std::nullopt;
+	};
+
+	for (size_t m = 0; m < gltfAsset.meshes.size() && m < meshes.size(); ++m) {
+		auto& textures = meshes[m].Textures;
+		textures.clear();
+		const auto AddTexture = [&](const auto& textureInfo) {
+			if (!textureInfo.has_value()) { return; }
+			const auto image = GetImage(textureInfo->textureIndex);
+			if (image && std::ranges::find(textures, *image) == textures.end()) { textures.push_back(*image); }
+		};
+
+		for (const auto& gltfPrimitive : gltfAsset.meshes[m].primitives) {
+			if (!gltfPrimitive.materialIndex.has_value()) { continue; }
+			const auto& material = gltfAsset.materials[*gltfPrimitive.materialIndex];
+			AddTexture(material.pbrData.baseColorTexture);
+			AddTexture(material.pbrData.metallicRoughnessTexture);
+			AddTexture(material.normalTexture);
+			AddTexture(material.occlusionTexture);
+			AddTexture(material.emissiveTexture);
+		}
+	}
+}
+
+/**
+ * Decide how each primitive of the mesh will be processed. This only reads the asset's accessor metadata, so it runs
+ * before any buffer data is available, and determines how many decode and process tasks the mesh needs.
+ */
+static void PlanMesh(GltfContext& context, size_t meshIndex) {
 	const auto& gltfAsset = context.GltfAsset;
 	const auto& gltfMesh  = gltfAsset.meshes[meshIndex];
 	auto& rawMesh         = context.RawMeshes[meshIndex];
 
-	// Start by sorting all of the primitives by their material.
+	// Start by sorting the primitive indices by their material, so that primitives which share a material end up
+	// adjacent in the merged mesh. Meshes only have a handful of primitives, so the order is kept inline.
 	const size_t defaultMaterialIndex = gltfAsset.materials.size();
-	std::vector<fastgltf::Primitive> gltfPrimitives(gltfMesh.primitives.begin(), gltfMesh.primitives.end());
-	std::sort(gltfPrimitives.begin(),
-	          gltfPrimitives.end(),
-	          [defaultMaterialIndex](const fastgltf::Primitive& a, const fastgltf::Primitive& b) -> bool {
-							return a.materialIndex.value_or(defaultMaterialIndex) > b.materialIndex.value_or(defaultMaterialIndex);
-						});
-
-	// Then, for each material, build a list of which primitives belong to each material.
-	std::vector<std::vector<int>> materialPrimitives(gltfAsset.materials.size() + 1);
-	for (uint32_t i = 0; i < gltfPrimitives.size(); ++i) {
-		const auto& gltfPrimitive = gltfPrimitives[i];
-		materialPrimitives[gltfPrimitive.materialIndex.value_or(defaultMaterialIndex)].push_back(i);
-	}
-	// Clean up any materials with no primitives.
-	materialPrimitives.erase(std::remove_if(materialPrimitives.begin(),
-	                                        materialPrimitives.end(),
-	                                        [](const std::vector<int>& material) { return material.empty(); }),
-	                         materialPrimitives.end());
-
-	// We are now left with a list of materials used by this mesh, and which primitives use those materials.
-	// We can use this information to merge primitives that use the same material into a single mesh.
-
-	auto& meshPositions = rawMesh.Positions;
-	auto& meshVertices  = rawMesh.Attributes;
-	auto& meshIndices   = rawMesh.Indices;
 
-	size_t vertexCount = 0;
+	const auto MaterialOf = [&](uint32_t primitiveIndex) -> size_t {
+		return gltfMesh.primitives[primitiveIndex].materialIndex.value_or(defaultMaterialIndex);
+	};
+	SmallVector<uint32_t, 16> primitiveOrder(gltfMesh.primitives.size());
+	std::iota(primitiveOrder.begin(), primitiveOrder.end(), 0);
+	std::sort(primitiveOrder.begin(), primitiveOrder.end(), [&](uint32_t a, uint32_t b) {
+		const auto materialA = MaterialOf(a);
+		const auto materialB = MaterialOf(b);
+
+		return materialA == materialB ? a < b : materialA < materialB;
+	});
+
+	rawMesh.Primitives.resize(primitiveOrder.size());
+	for (size_t i = 0; i < primitiveOrder.size(); ++i) {
+		const auto& gltfPrimitive = gltfMesh.primitives[primitiveOrder[i]];
+		const auto* positions     = FindAccessor(gltfAsset, gltfPrimitive, VertexAttributeBits::Position);
+		const auto* indices       = FindAccessor(gltfAsset, gltfPrimitive, VertexAttributeBits::Index);
+		auto& primitive           = rawMesh.Primitives[i];
+
+		primitive.PrimitiveIndex = primitiveOrder[i];
+		primitive.Steps          = GetProcessingSteps(GetAvailableAttributes(gltfPrimitive));
+		primitive.Splittable     = !indices || (primitive.Steps & MeshProcessingStepBits::UnpackVertices);
+		primitive.VertexCount    = positions ? positions->count : 0;
+		primitive.IndexCount     = indices ? indices->count : 0;
+
+		if (primitive.Splittable) {
+			const size_t elementCount = indices ? primitive.IndexCount : primitive.VertexCount;
+			for (size_t first = 0; first < elementCount; first += ProcessRangeSize) {
+				primitive.Ranges.push_back({.First = first, .Count = std::min(ProcessRangeSize, elementCount - first)});
+			}
+		} else {
+			primitive.Ranges.push_back({.First = 0, .Count = primitive.IndexCount});
+		}
+	}
+}
 
-	for (size_t materialIndex = 0; materialIndex < materialPrimitives.size(); ++materialIndex) {
-		const auto& primitiveList = materialPrimitives[materialIndex];
+static void AllocatePrimitives(GltfContext& context, size_t meshIndex) {
+	for (auto& primitive : context.RawMeshes[meshIndex].Primitives) {
+		primitive.Positions.resize(primitive.VertexCount);
+		primitive.Attributes.resize(primitive.VertexCount);
+		primitive.Indices.resize(primitive.IndexCount);
+	}
+}
 
-		glm::vec3 boundsMin(std::numeric_limits<float>::max());
-		glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+static void DecodeVertices(GltfContext& context, size_t meshIndex, size_t primitiveIndex, size_t first, size_t count) {
+	const auto& gltfAsset     = context.GltfAsset;
+	const auto& buffers       = context.Buffers;
+	auto& primitive           = context.RawMeshes[meshIndex].Primitives[primitiveIndex];
+	const auto& gltfPrimitive = gltfAsset.meshes[meshIndex].primitives[primitive.PrimitiveIndex];
 
-		for (const auto gltfPrimitiveIndex : primitiveList) {
-			const auto& gltfPrimitive = gltfPrimitives[gltfPrimitiveIndex];
-			const auto primAttributes = GetAvailableAttributes(gltfPrimitive);
-			const auto primProcessing = GetProcessingSteps(primAttributes);
+	std::vector<glm::vec3> normals(count);
+	std::vector<glm::vec4> tangents(count);
+	std::vector<glm::vec2> texcoord0(count);
 
-			std::vector<glm::vec3> positions;
-			std::vector<Vertex> vertices;
-			std::vector<uint32_t> indices;
+	const auto positions = std::span(primitive.Positions).subspan(first, count);
+	GetAccessorData(gltfAsset, buffers, gltfPrimitive, VertexAttributeBits::Position, first, positions);
+	GetAccessorData(gltfAsset, buffers, gltfPrimitive, VertexAttributeBits::Normal, first, std::span(normals));
+	GetAccessorData(gltfAsset, buffers, gltfPrimitive, VertexAttributeBits::Tangent, first, std::span(tangents));
+	GetAccessorData(gltfAsset, buffers, gltfPrimitive, VertexAttributeBits::Texcoord0, first, std::span(texcoord0));
 
-			{
-				const auto& buffers = context.Buffers;
+	for (size_t i = 0; i < count; ++i) {
+		primitive.Attributes[first + i] = Vertex{.Normal = normals[i], .Tangent = tangents[i], .Texcoord0 = texcoord0[i]};
+	}
+}
 
-				positions      = GetAccessorData<glm::vec3>(gltfAsset, buffers, gltfPrimitive, VertexAttributeBits::Position);
-				auto normals   = GetAccessorData<glm::vec3>(gltfAsset, buffers, gltfPrimitive, VertexAttributeBits::Normal);
-				auto tangents  = GetAccessorData<glm::vec4>(gltfAsset, buffers, gltfPrimitive, VertexAttributeBits::Tangent);
-				auto texcoord0 = GetAccessorData<glm::vec2>(gltfAsset, buffers, gltfPrimitive, VertexAttributeBits::Texcoord0);
+static void DecodeIndices(GltfContext& context, size_t meshIndex, size_t primitiveIndex, size_t first, size_t count) {
+	const auto& gltfAsset     = context.GltfAsset;
+	auto& primitive           = context.RawMeshes[meshIndex].Primitives[primitiveIndex];
+	const auto& gltfPrimitive = gltfAsset.meshes[meshIndex].primitives[primitive.PrimitiveIndex];
 
-				normals.resize(positions.size());
-				tangents.resize(positions.size());
-				texcoord0.resize(positions.size());
+	const auto indices = std::span(primitive.Indices).subspan(first, count);
+	GetAccessorData(gltfAsset, context.Buffers, gltfPrimitive, VertexAttributeBits::Index, first, indices);
+}
 
-				vertices.reserve(positions.size());
-				for (size_t i = 0; i < positions.size(); ++i) {
-					vertices.push_back(Vertex{.Normal = normals[i], .Tangent = tangents[i], .Texcoord0 = texcoord0[i]});
-				}
+static void ProcessPrimitiveRange(GltfContext& context, size_t meshIndex, size_t primitiveIndex, size_t rangeIndex) {
+	auto& primitive = context.RawMeshes[meshIndex].Primitives[primitiveIndex];
+	auto& range     = primitive.Ranges[rangeIndex];
+	auto& positions = range.Positions;
+	auto& vertices  = range.Attributes;
+	auto& indices   = range.Indices;
+
+	// An unsplittable primitive is always indexed and already has everything it needs, so it is used as-is.
+	if (!primitive.Splittable) {
+		positions = std::move(primitive.Positions);
+		vertices  = std::move(primitive.Attributes);
+		indices   = std::move(primitive.Indices);
+		return;
+	}
 
-				indices = GetAccessorData<uint32_t>(gltfAsset, buffers, gltfPrimitive, VertexAttributeBits::Index);
-			}
+	// Gather the range's triangles, unpacking them through the index buffer if there is one.
+	positions.resize(range.Count);
+	vertices.resize(range.Count);
+	if (!primitive.Indices.empty()) {
+		for (size_t i = 0; i < range.Count; ++i) {
+			const uint32_t index = primitive.Indices[range.First + i];
+			positions[i]         = primitive.Positions[index];
+			vertices[i]          = primitive.Attributes[index];
+		}
+	} else {
+		std::copy_n(primitive.Positions.begin() + range.First, range.Count, positions.begin());
+		std::copy_n(primitive.Attributes.begin() + range.First, range.Count, vertices.begin());
+	}
 
-			if (primProcessing & MeshProcessingStepBits::UnpackVertices) {
-				if (indices.size() > 0) {
-					std::vector<glm::vec3> newPositions(indices.size());
-					std::vector<Vertex> newAttributes(indices.size());
+	if (primitive.Steps & MeshProcessingStepBits::GenerateFlatNormals) {
+		const size_t faceCount = vertices.size() / 3;
+
+		for (size_t i = 0; i < faceCount; ++i) {
+			auto& p1     = positions[i * 3 + 0];
+			auto& p2     = positions[i * 3 + 1];
+			auto& p3     = positions[i * 3 + 2];
+			auto& v1     = vertices[i * 3 + 0];
+			auto& v2     = vertices[i * 3 + 1];
+			auto& v3     = vertices[i * 3 + 2];
+			const auto n = glm::normalize(glm::triangleNormal(p1, p2, p3));
+
+			v1.Normal = n;
+			v2.Normal = n;
+			v3.Normal = n;
+		}
+	}
 
-					uint32_t newIndex = 0;
-					for (const uint32_t index : indices) {
-						newPositions[newIndex]  = positions[index];
-						newAttributes[newIndex] = vertices[index];
-						++newIndex;
-					}
-					positions = std::move(newPositions);
-					vertices  = std::move(newAttributes);
-				}
-			}
+	if (primitive.Steps & MeshProcessingStepBits::GenerateTangentSpace) {
+		// MikkTContext context{positions, vertices};
+		// mikktContext.m_pUserData = &context;
+		// genTangSpaceDefault(&mikktContext);
+	}
 
-			if (primProcessing & MeshProcessingStepBits::GenerateFlatNormals) {
-				const size_t faceCount = vertices.size() / 3;
-
-				for (size_t i = 0; i < faceCount; ++i) {
-					auto& p1     = positions[i * 3 + 0];
-					auto& p2     = positions[i * 3 + 1];
-					auto& p3     = positions[i * 3 + 2];
-					auto& v1     = vertices[i * 3 + 0];
-					auto& v2     = vertices[i * 3 + 1];
-					auto& v3     = vertices[i * 3 + 2];
-					const auto n = glm::normalize(glm::triangleNormal(p1, p2, p3));
-
-					v1.Normal = n;
-					v2.Normal = n;
-					v3.Normal = n;
-				}
-			}
+	// Vertices are welded by comparing their bytes, so Vertex must not contain any padding.
+	static_assert(sizeof(Vertex) == sizeof(Vertex::Normal) + sizeof(Vertex::Tangent) + sizeof(Vertex::Texcoord0) +
+	                                  sizeof(Vertex::Texcoord1) + sizeof(Vertex::Color0) + sizeof(Vertex::Joints0) +
+	                                  sizeof(Vertex::Weights0),
+	              "Vertex must be tightly packed to be welded");
+
+	// Welding is done per range. Vertices shared across a range boundary are duplicated, which costs a little memory on
+	// huge primitives but lets each range weld without synchronizing with the others.
+	const size_t vertexCount = vertices.size();
+	indices.resize(vertexCount);
+	if (primitive.Steps & MeshProcessingStepBits::WeldVertices) {
+		const std::array<meshopt_Stream, 2> streams = {
+			meshopt_Stream{positions.data(), sizeof(glm::vec3), sizeof(glm::vec3)},
+			meshopt_Stream{vertices.data(), sizeof(Vertex), sizeof(Vertex)}};
+
+		// The range is an unindexed triangle list, so the remap table is also the welded index buffer; remapping an
+		// identity index buffer through it would just copy it.
+		const auto uniqueCount = meshopt_generateVertexRemapMulti(
+			indices.data(), nullptr, vertexCount, vertexCount, streams.data(), streams.size());
+		meshopt_remapVertexBuffer(positions.data(), positions.data(), vertexCount, sizeof(glm::vec3), indices.data());
+		meshopt_remapVertexBuffer(vertices.data(), vertices.data(), vertexCount, sizeof(Vertex), indices.data());
+		positions.resize(uniqueCount);
+		vertices.resize(uniqueCount);
+	} else {
+		std::iota(indices.begin(), indices.end(), 0);
+	}
+}
 
-			if (primProcessing & MeshProcessingStepBits::GenerateTangentSpace) {
-				// MikkTContext context{positions, vertices};
-				// mikktContext.m_pUserData = &context;
-				// genTangSpaceDefault(&mikktContext);
-			}
+/**
+ * Assign every processed range its place in the merged mesh, and size the mesh to fit. The decoded primitive data is
+ * no longer needed at this point, so it is released here.
+ */
+static void AllocateMesh(GltfContext& context, size_t meshIndex) {
+	auto& rawMesh = context.RawMeshes[meshIndex];
 
-			if (primProcessing & MeshProcessingStepBits::WeldVertices) {
-				indices.clear();
-				indices.reserve(vertices.size());
-				std::unordered_map<CombinedVertex, uint32_t> uniqueVertices;
-
-				const size_t oldVertexCount = vertices.size();
-				uint32_t newVertexCount     = 0;
-				for (size_t i = 0; i < oldVertexCount; ++i) {
-					const CombinedVertex v = {positions[i], vertices[i]};
-
-					const auto it = uniqueVertices.find(v);
-					if (it == uniqueVertices.end()) {
-						const uint32_t index = newVertexCount++;
-						uniqueVertices.insert(std::make_pair(v, index));
-						positions[index] = v.Position;
-						vertices[index]  = v.Attributes;
-						indices.push_back(index);
-					} else {
-						indices.push_back(it->second);
-					}
-				}
-				positions.resize(newVertexCount);
-				vertices.resize(newVertexCount);
-			}
+	size_t vertexCount = 0;
+	size_t indexCount  = 0;
+	for (auto& primitive : rawMesh.Primitives) {
+		primitive.Positions  = {};
+		primitive.Attributes = {};
+		primitive.Indices    = {};
+
+		for (auto& range : primitive.Ranges) {
+			range.VertexOffset = vertexCount;
+			range.IndexOffset  = indexCount;
+			vertexCount += range.Positions.size();
+			indexCount += range.Indices.size();
+		}
+	}
 
-			for (const auto& v : positions) {
-				boundsMin = glm::min(v, boundsMin);
-				boundsMax = glm::max(v, boundsMax);
-			}
+	rawMesh.Positions.resize(vertexCount);
+	rawMesh.Attributes.resize(vertexCount);
+	rawMesh.Indices.resize(indexCount);
+}
 
-			for (auto& i : indices) { i += vertexCount; }
+static void MergePrimitiveRange(GltfContext& context, size_t meshIndex, size_t primitiveIndex, size_t rangeIndex) {
+	auto& rawMesh = context.RawMeshes[meshIndex];
+	auto& range   = rawMesh.Primitives[primitiveIndex].Ranges[rangeIndex];
 
-			std::ranges::copy(positions, std::back_inserter(meshPositions));
-			std::ranges::copy(vertices, std::back_inserter(meshVertices));
-			std::ranges::copy(indices, std::back_inserter(meshIndices));
+	const auto vertexOffset = uint32_t(range.VertexOffset);
+	std::ranges::copy(range.Positions, rawMesh.Positions.begin() + range.VertexOffset);
+	std::ranges::copy(range.Attributes, rawMesh.Attributes.begin() + range.VertexOffset);
+	std::ranges::transform(range.Indices, rawMesh.Indices.begin() + range.IndexOffset, [vertexOffset](uint32_t index) {
+		return index + vertexOffset;
+	});
 
-			vertexCount += positions.size();
-		}
-	}
+	range.Positions  = {};
+	range.Attributes = {};
+	range.Indices    = {};
 }
 
 static void LoadNode(GltfContext& context, size_t nodeIndex) {
@@ -517,205 +914,1562 @@ static void LoadNode(GltfContext& context, size_t nodeIndex) {
 	}
 }
 
-static void BuildMeshlets(GltfContext& context, size_t meshIndex) {
-	auto& mesh = context.RawMeshes[meshIndex];
-
-	constexpr static int MaxMeshletIndices   = 64;
-	constexpr static int MaxMeshletTriangles = 64;
-	const auto maxMeshlets = meshopt_buildMeshletsBound(mesh.Indices.size(), MaxMeshletIndices, MaxMeshletTriangles);
-
+/** Split a triangle list into meshlets, appended to the mesh's meshlet arrays. Returns the first new meshlet. */
+static size_t AppendMeshlets(GltfMesh& mesh, std::span<const uint32_t> indices, const GltfClusterLod& lod) {
 	auto& meshlets         = mesh.Meshlets;
 	auto& meshletIndices   = mesh.MeshletIndices;
 	auto& meshletTriangles = mesh.MeshletTriangles;
-	meshlets.resize(maxMeshlets);
-	meshletIndices.resize(maxMeshlets * MaxMeshletIndices);
-	meshletTriangles.resize(maxMeshlets * MaxMeshletTriangles * 3);
-
-	const auto meshletCount = meshopt_buildMeshlets(meshlets.data(),
-	                                                meshletIndices.data(),
-	                                                meshletTriangles.data(),
-	                                                mesh.Indices.data(),
-	                                                mesh.Indices.size(),
+
+	const auto maxMeshlets = meshopt_buildMeshletsBound(indices.size(), MaxMeshletIndices, MaxMeshletTriangles);
+
+	const size_t meshletOffset  = meshlets.size();
+	const size_t indexOffset    = meshletIndices.size();
+	const size_t triangleOffset = meshletTriangles.size();
+	meshlets.resize(meshletOffset + maxMeshlets);
+	meshletIndices.resize(indexOffset + maxMeshlets * MaxMeshletIndices);
+	meshletTriangles.resize(triangleOffset + maxMeshlets * MaxMeshletTriangles * 3);
+
+	const auto meshletCount = meshopt_buildMeshlets(meshlets.data() + meshletOffset,
+	                                                meshletIndices.data() + indexOffset,
+	                                                meshletTriangles.data() + triangleOffset,
+	                                                indices.data(),
+	                                                indices.size(),
 	                                                reinterpret_cast<const float*>(mesh.Positions.data()),
 	                                                mesh.Positions.size(),
 	                                                sizeof(glm::vec3),
 	                                                MaxMeshletIndices,
 	                                                MaxMeshletTriangles,
 	                                                0.0f);
-	meshlets.resize(meshletCount);
+	meshlets.resize(meshletOffset + meshletCount);
+	mesh.MeshletLods.resize(meshletOffset + meshletCount, lod);
+	if (meshletCount == 0) {
+		meshletIndices.resize(indexOffset);
+		meshletTriangles.resize(triangleOffset);
+		return meshletOffset;
+	}
+
+	// Within each meshlet, order triangles for vertex reuse and vertices by first use.
+	for (size_t i = meshletOffset; i < meshlets.size(); ++i) {
+		auto& meshlet = meshlets[i];
+		meshlet.vertex_offset += indexOffset;
+		meshlet.triangle_offset += triangleOffset;
+		meshopt_optimizeMeshlet(meshletIndices.data() + meshlet.vertex_offset,
+		                        meshletTriangles.data() + meshlet.triangle_offset,
+		                        meshlet.triangle_count,
+		                        meshlet.vertex_count);
+	}
 
 	const auto& lastMeshlet = meshlets.back();
 	meshletIndices.resize(lastMeshlet.vertex_offset + lastMeshlet.vertex_count);
 	meshletTriangles.resize(lastMeshlet.triangle_offset + ((lastMeshlet.triangle_count * 3 + 3) & ~3));
+
+	return meshletOffset;
 }
 
-static void CombineMeshlets(GltfContext& context) {
-	size_t vertexOffset   = context.Positions.size();
-	size_t indexOffset    = context.Indices.size();
-	size_t triangleOffset = context.Triangles.size();
+/**
+ * Reorder the mesh's triangles for post-transform vertex reuse, then its vertices in the order those triangles first
+ * reference them, so neighbouring triangles and meshlets read neighbouring vertices. Unreferenced vertices are dropped.
+ */
+static void OptimizeMesh(GltfMesh& mesh) {
+	auto& indices = mesh.Indices;
+	meshopt_optimizeVertexCache(indices.data(), indices.data(), indices.size(), mesh.Positions.size());
+
+	// Positions and attributes live in separate streams, so both are remapped by the same fetch order.
+	std::vector<uint32_t> remap(mesh.Positions.size());
+	const auto vertexCount =
+		meshopt_optimizeVertexFetchRemap(remap.data(), indices.data(), indices.size(), mesh.Positions.size());
+	meshopt_remapIndexBuffer(indices.data(), indices.data(), indices.size(), remap.data());
+	meshopt_remapVertexBuffer(
+		mesh.Positions.data(), mesh.Positions.data(), mesh.Positions.size(), sizeof(glm::vec3), remap.data());
+	meshopt_remapVertexBuffer(
+		mesh.Attributes.data(), mesh.Attributes.data(), mesh.Attributes.size(), sizeof(Vertex), remap.data());
+	mesh.Positions.resize(vertexCount);
+	mesh.Attributes.resize(vertexCount);
+}
+
+/** Append the mesh vertex indices of a meshlet's triangles to indices. */
+static void GetMeshletTriangles(const GltfMesh& mesh, size_t meshletIndex, std::vector<uint32_t>& indices) {
+	const auto& meshlet = mesh.Meshlets[meshletIndex];
+	for (uint32_t i = 0; i < meshlet.triangle_count * 3; ++i) {
+		const auto vertex = mesh.MeshletTriangles[meshlet.triangle_offset + i];
+		indices.push_back(mesh.MeshletIndices[meshlet.vertex_offset + vertex]);
+	}
+}
+
+/** Find a sphere which encloses every given sphere. */
+static glm::vec4 MergeSpheres(std::span<const glm::vec4> spheres) {
+	glm::vec3 boundsMin(std::numeric_limits<float>::max());
+	glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+	for (const auto& sphere : spheres) {
+		boundsMin = glm::min(boundsMin, glm::vec3(sphere) - sphere.w);
+		boundsMax = glm::max(boundsMax, glm::vec3(sphere) + sphere.w);
+	}
+
+	const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+	float radius           = 0.0f;
+	for (const auto& sphere : spheres) { radius = std::max(radius, glm::distance(center, glm::vec3(sphere)) + sphere.w); }
+
+	return glm::vec4(center, radius);
+}
+
+/**
+ * Partition clusters into groups of up to ClusterGroupSize. Each group grows from a seed cluster by repeatedly adding
+ * the ungrouped cluster which shares the most vertices with one of its members. Vertices are compared by position, so
+ * clusters on either side of an attribute seam still count as neighbours.
+ */
+static std::vector<std::vector<size_t>> GroupClusters(const GltfMesh& mesh,
+                                                      std::span<const size_t> clusters,
+                                                      std::span<const uint32_t> positionRemap) {
+	// Pairs of (position, cluster), sorted so every cluster touching a position is adjacent.
+	std::vector<std::pair<uint32_t, uint32_t>> references;
+	for (uint32_t c = 0; c < clusters.size(); ++c) {
+		const auto& meshlet = mesh.Meshlets[clusters[c]];
+		for (uint32_t i = 0; i < meshlet.vertex_count; ++i) {
+			references.emplace_back(positionRemap[mesh.MeshletIndices[meshlet.vertex_offset + i]], c);
+		}
+	}
+	std::ranges::sort(references);
+	references.erase(std::unique(references.begin(), references.end()), references.end());
+
+	std::vector<std::unordered_map<uint32_t, uint32_t>> sharedVertices(clusters.size());
+	for (size_t first = 0; first < references.size();) {
+		size_t last = first + 1;
+		while (last < references.size() && references[last].first == references[first].first) { ++last; }
+		for (size_t a = first; a < last; ++a) {
+			for (size_t b = a + 1; b < last; ++b) {
+				++sharedVertices[references[a].second][references[b].second];
+				++sharedVertices[references[b].second][references[a].second];
+			}
+		}
+		first = last;
+	}
 
-	for (size_t meshIndex = 0; meshIndex < context.RawMeshes.size(); ++meshIndex) {
-		auto& rawMesh                = context.RawMeshes[meshIndex];
-		auto& mesh                   = context.Meshes[meshIndex];
-		const auto& meshletIndices   = rawMesh.MeshletIndices;
-		const auto& meshletTriangles = rawMesh.MeshletTriangles;
-
-		for (const auto& meshlet : rawMesh.Meshlets) {
-			glm::vec3 aabbMin(std::numeric_limits<float>::max());
-			glm::vec3 aabbMax(std::numeric_limits<float>::lowest());
-			for (uint32_t i = 0; i < meshlet.triangle_count * 3; ++i) {
-				const auto& pos =
-					rawMesh.Positions[meshletIndices[meshlet.vertex_offset + meshletTriangles[meshlet.triangle_offset + i]]];
-				aabbMin = glm::min(aabbMin, pos);
-				aabbMax = glm::max(aabbMax, pos);
+	std::vector<bool> grouped(clusters.size(), false);
+	std::vector<std::vector<size_t>> groups;
+	std::vector<uint32_t> members;
+	for (uint32_t seed = 0; seed < clusters.size(); ++seed) {
+		if (grouped[seed]) { continue; }
+
+		grouped[seed] = true;
+		members       = {seed};
+		while (members.size() < ClusterGroupSize) {
+			uint32_t best       = 0;
+			uint32_t bestShared = 0;
+			for (const auto member : members) {
+				for (const auto [neighbour, shared] : sharedVertices[member]) {
+					if (!grouped[neighbour] && shared > bestShared) {
+						best       = neighbour;
+						bestShared = shared;
+					}
+				}
 			}
+			if (bestShared == 0) { break; }
 
-			mesh.Meshlets.emplace_back(Meshlet{.VertexOffset   = uint32_t(vertexOffset),
-			                                   .IndexOffset    = uint32_t(indexOffset + meshlet.vertex_offset),
-			                                   .TriangleOffset = uint32_t(triangleOffset + meshlet.triangle_offset),
-			                                   .IndexCount     = uint32_t(meshlet.vertex_count),
-			                                   .TriangleCount  = uint32_t(meshlet.triangle_count),
-			                                   .AABBMin        = aabbMin,
-			                                   .AABBMax        = aabbMax});
+			grouped[best] = true;
+			members.push_back(best);
 		}
 
+		auto& group = groups.emplace_back();
+		for (const auto member : members) { group.push_back(clusters[member]); }
+	}
+
+	return groups;
+}
+
+/**
+ * Build the mesh's meshlets as a cluster DAG for continuous level of detail.
+ *
+ * The full-detail meshlets form the first level. Each following level groups neighbouring clusters of the previous
+ * one, simplifies every group with its border locked so it still meets its neighbours, and splits the result back into
+ * clusters. A group's error and bounds enclose those of the clusters it was built from, so the projected error only
+ * grows from a cluster to its parent and the renderer can choose a consistent cut one cluster at a time.
+ */
+static void BuildMeshlets(GltfContext& context, size_t meshIndex) {
+	auto& mesh = context.RawMeshes[meshIndex];
+	if (mesh.Indices.empty()) { return; }
+
+	OptimizeMesh(mesh);
+
+	const auto* positions    = reinterpret_cast<const float*>(mesh.Positions.data());
+	const auto* normals      = glm::value_ptr(mesh.Attributes[0].Normal);
+	const size_t vertexCount = mesh.Positions.size();
+	const float scale        = meshopt_simplifyScale(positions, vertexCount, sizeof(glm::vec3));
+
+	constexpr static std::array<float, 3> NormalWeights = {
+		ClusterNormalWeight, ClusterNormalWeight, ClusterNormalWeight};
+
+	// Map every vertex to the first vertex sharing its position.
+	std::vector<uint32_t> vertexIndices(vertexCount);
+	std::vector<uint32_t> positionRemap(vertexCount);
+	std::iota(vertexIndices.begin(), vertexIndices.end(), 0u);
+	meshopt_generateShadowIndexBuffer(positionRemap.data(),
+	                                  vertexIndices.data(),
+	                                  vertexCount,
+	                                  positions,
+	                                  vertexCount,
+	                                  sizeof(glm::vec3),
+	                                  sizeof(glm::vec3));
+
+	// Full-detail clusters have no error, so their bounds only need to enclose their own triangles.
+	AppendMeshlets(mesh, mesh.Indices, GltfClusterLod{});
+	mesh.Indices = {};
+	std::vector<size_t> clusters(mesh.Meshlets.size());
+	std::iota(clusters.begin(), clusters.end(), size_t(0));
+	for (const auto c : clusters) {
+		const auto& meshlet = mesh.Meshlets[c];
+		const auto bounds   = meshopt_computeMeshletBounds(&mesh.MeshletIndices[meshlet.vertex_offset],
+		                                                   &mesh.MeshletTriangles[meshlet.triangle_offset],
+		                                                   meshlet.triangle_count,
+		                                                   positions,
+		                                                   vertexCount,
+		                                                   sizeof(glm::vec3));
+		mesh.MeshletLods[c].Bounds = glm::vec4(glm::make_vec3(bounds.center), bounds.radius);
+	}
+
+	std::vector<uint32_t> groupIndices;
+	std::vector<uint32_t> simplified;
+	std::vector<glm::vec4> childBounds;
+	for (size_t level = 1; level < MaxClusterLevels && clusters.size() > 1; ++level) {
+		std::vector<size_t> nextClusters;
+		for (const auto& group : GroupClusters(mesh, clusters, positionRemap)) {
+			groupIndices.clear();
+			childBounds.clear();
+			float childError = 0.0f;
+			for (const auto c : group) {
+				GetMeshletTriangles(mesh, c, groupIndices);
+				childBounds.push_back(mesh.MeshletLods[c].Bounds);
+				childError = std::max(childError, mesh.MeshletLods[c].Error);
+			}
+
+			const size_t targetCount = size_t(float(groupIndices.size() / 3) * ClusterReduction) * 3;
+			float error              = 0.0f;
+			simplified.resize(groupIndices.size());
+			simplified.resize(meshopt_simplifyWithAttributes(simplified.data(),
+			                                                 groupIndices.data(),
+			                                                 groupIndices.size(),
+			                                                 positions,
+			                                                 vertexCount,
+			                                                 sizeof(glm::vec3),
+			                                                 normals,
+			                                                 sizeof(Vertex),
+			                                                 NormalWeights.data(),
+			                                                 NormalWeights.size(),
+			                                                 nullptr,
+			                                                 targetCount,
+			                                                 std::numeric_limits<float>::max(),
+			                                                 meshopt_SimplifyLockBorder,
+			                                                 &error));
+
+			// Groups which cannot be simplified any further are left as roots of the DAG.
+			const float reduction = float(simplified.size()) / float(groupIndices.size());
+			if (simplified.empty() || reduction > ClusterMinReduction) { continue; }
+
+			const GltfClusterLod groupLod = {.Bounds = MergeSpheres(childBounds), .Error = childError + error * scale};
+			for (const auto c : group) {
+				mesh.MeshletLods[c].ParentBounds = groupLod.Bounds;
+				mesh.MeshletLods[c].ParentError  = groupLod.Error;
+			}
+
+			const size_t firstMeshlet = AppendMeshlets(mesh, simplified, groupLod);
+			for (size_t c = firstMeshlet; c < mesh.Meshlets.size(); ++c) { nextClusters.push_back(c); }
+		}
+		clusters = std::move(nextClusters);
+	}
+}
+
+/** Assign every mesh its place in the combined scene arrays, and size the arrays to fit. */
+static void AllocateCombinedMeshes(GltfContext& context) {
+	size_t vertexOffset   = context.Positions.size();
+	size_t indexOffset    = context.Indices.size();
+	size_t triangleOffset = context.Triangles.size();
+
+	for (auto& rawMesh : context.RawMeshes) {
+		rawMesh.VertexOffset   = vertexOffset;
+		rawMesh.IndexOffset    = indexOffset;
+		rawMesh.TriangleOffset = triangleOffset;
+
 		vertexOffset += rawMesh.Positions.size();
 		indexOffset += rawMesh.MeshletIndices.size();
 		triangleOffset += rawMesh.MeshletTriangles.size();
+	}
 
-		std::ranges::move(rawMesh.Positions, std::back_inserter(context.Positions));
-		std::ranges::move(rawMesh.Attributes, std::back_inserter(context.Attributes));
-		std::ranges::move(rawMesh.MeshletIndices, std::back_inserter(context.Indices));
-		std::ranges::move(rawMesh.MeshletTriangles, std::back_inserter(context.Triangles));
-		break;
+	context.Positions.resize(vertexOffset);
+	if (context.Format == VertexFormat::Quantized) {
+		context.QuantizedAttributes.resize(vertexOffset);
+	} else {
+		context.Attributes.resize(vertexOffset);
 	}
+	context.Indices.resize(indexOffset);
+	context.Triangles.resize(triangleOffset);
+}
+
+/** Map a direction onto the octahedron, unfolded into [-1, 1]^2. A zero vector maps to the origin. */
+static glm::vec2 OctEncode(const glm::vec3& v) {
+	const float length = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+	if (length == 0.0f) { return glm::vec2(0.0f); }
+
+	const glm::vec3 n = v / length;
+	if (n.z >= 0.0f) { return glm::vec2(n.x, n.y); }
+
+	return (1.0f - glm::abs(glm::vec2(n.y, n.x))) *
+	       glm::vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
 }
 
-glm::mat4 Scene::Node::GetGlobalTransform() const noexcept {
-	if (Parent) {
-		return Parent->GetGlobalTransform() * Transform;
+static uint32_t PackSnorm16x2(const glm::vec2& v) {
+	return uint32_t(uint16_t(meshopt_quantizeSnorm(v.x, 16))) |
+	       (uint32_t(uint16_t(meshopt_quantizeSnorm(v.y, 16))) << 16);
+}
+
+static uint32_t PackHalf2(const glm::vec2& v) {
+	return uint32_t(meshopt_quantizeHalf(v.x)) | (uint32_t(meshopt_quantizeHalf(v.y)) << 16);
+}
+
+static uint32_t PackUnorm8x4(const glm::vec4& v) {
+	return uint32_t(meshopt_quantizeUnorm(v.x, 8)) | (uint32_t(meshopt_quantizeUnorm(v.y, 8)) << 8) |
+	       (uint32_t(meshopt_quantizeUnorm(v.z, 8)) << 16) | (uint32_t(meshopt_quantizeUnorm(v.w, 8)) << 24);
+}
+
+/** Must be kept in sync with DecodeVertex() in Common.glsli. */
+static QuantizedVertex QuantizeVertex(const Vertex& vertex) {
+	// The tangent's handedness takes the place of the lowest bit of its second component.
+	const uint32_t tangent   = PackSnorm16x2(OctEncode(glm::vec3(vertex.Tangent)));
+	const uint32_t sign      = vertex.Tangent.w < 0.0f ? 1u << 16 : 0u;
+	const glm::uvec4 joints0 = glm::min(vertex.Joints0, glm::uvec4(255));
+
+	return QuantizedVertex{
+		.Normal    = PackSnorm16x2(OctEncode(vertex.Normal)),
+		.Tangent   = (tangent & ~(1u << 16)) | sign,
+		.Texcoord0 = PackHalf2(vertex.Texcoord0),
+		.Texcoord1 = PackHalf2(vertex.Texcoord1),
+		.Color0    = PackUnorm8x4(vertex.Color0),
+		.Joints0   = joints0.x | (joints0.y << 8) | (joints0.z << 16) | (joints0.w << 24),
+		.Weights0  = PackUnorm8x4(vertex.Weights0)};
+}
+
+static void CombineMeshlets(GltfContext& context, size_t meshIndex) {
+	auto& rawMesh                = context.RawMeshes[meshIndex];
+	auto& mesh                   = context.Meshes[meshIndex];
+	const auto& meshletIndices   = rawMesh.MeshletIndices;
+	const auto& meshletTriangles = rawMesh.MeshletTriangles;
+
+	mesh.Meshlets.reserve(rawMesh.Meshlets.size());
+	for (size_t meshletIndex = 0; meshletIndex < rawMesh.Meshlets.size(); ++meshletIndex) {
+		const auto& meshlet = rawMesh.Meshlets[meshletIndex];
+		const auto& lod     = rawMesh.MeshletLods[meshletIndex];
+		glm::vec3 aabbMin(std::numeric_limits<float>::max());
+		glm::vec3 aabbMax(std::numeric_limits<float>::lowest());
+		for (uint32_t i = 0; i < meshlet.triangle_count * 3; ++i) {
+			const auto& pos =
+				rawMesh.Positions[meshletIndices[meshlet.vertex_offset + meshletTriangles[meshlet.triangle_offset + i]]];
+			aabbMin = glm::min(aabbMin, pos);
+			aabbMax = glm::max(aabbMax, pos);
+		}
+
+		const auto bounds = meshopt_computeMeshletBounds(&meshletIndices[meshlet.vertex_offset],
+		                                                 &meshletTriangles[meshlet.triangle_offset],
+		                                                 meshlet.triangle_count,
+		                                                 reinterpret_cast<const float*>(rawMesh.Positions.data()),
+		                                                 rawMesh.Positions.size(),
+		                                                 sizeof(glm::vec3));
+		const uint32_t coneAxisCutoff =
+			uint32_t(uint8_t(bounds.cone_axis_s8[0])) | (uint32_t(uint8_t(bounds.cone_axis_s8[1])) << 8) |
+			(uint32_t(uint8_t(bounds.cone_axis_s8[2])) << 16) | (uint32_t(uint8_t(bounds.cone_cutoff_s8)) << 24);
+
+		mesh.Meshlets.emplace_back(Meshlet{.VertexOffset    = uint32_t(rawMesh.VertexOffset),
+		                                   .IndexOffset     = uint32_t(rawMesh.IndexOffset + meshlet.vertex_offset),
+		                                   .TriangleOffset  = uint32_t(rawMesh.TriangleOffset + meshlet.triangle_offset),
+		                                   .IndexCount      = uint32_t(meshlet.vertex_count),
+		                                   .TriangleCount   = uint32_t(meshlet.triangle_count),
+		                                   .AABBMin         = aabbMin,
+		                                   .AABBMax         = aabbMax,
+		                                   .SphereCenter    = glm::make_vec3(bounds.center),
+		                                   .SphereRadius    = bounds.radius,
+		                                   .ConeApex        = glm::make_vec3(bounds.cone_apex),
+		                                   .ConeAxisCutoff  = coneAxisCutoff,
+		                                   .LodBounds       = lod.Bounds,
+		                                   .LodError        = lod.Error,
+		                                   .ParentLodBounds = lod.ParentBounds,
+		                                   .ParentLodError  = lod.ParentError});
+	}
+
+	std::ranges::copy(rawMesh.Positions, context.Positions.begin() + rawMesh.VertexOffset);
+	if (context.Format == VertexFormat::Quantized) {
+		std::ranges::transform(
+			rawMesh.Attributes, context.QuantizedAttributes.begin() + rawMesh.VertexOffset, QuantizeVertex);
 	} else {
-		return Transform;
+		std::ranges::copy(rawMesh.Attributes, context.Attributes.begin() + rawMesh.VertexOffset);
 	}
+	std::ranges::copy(rawMesh.MeshletIndices, context.Indices.begin() + rawMesh.IndexOffset);
+	std::ranges::copy(rawMesh.MeshletTriangles, context.Triangles.begin() + rawMesh.TriangleOffset);
+
+	rawMesh.Positions        = {};
+	rawMesh.Attributes       = {};
+	rawMesh.MeshletIndices   = {};
+	rawMesh.MeshletTriangles = {};
+	rawMesh.MeshletLods      = {};
+}
+
+Scene::~Scene() noexcept {
+	if (_loadThread.joinable()) { _loadThread.join(); }
 }
 
 void Scene::Clear() {
+	// The loading thread only touches its own Scene, but waits on worker tasks and so must not outlive the engine.
+	if (_loadThread.joinable()) { _loadThread.join(); }
 	_meshes.clear();
 	_nodes.clear();
 	_rootNodes.clear();
 	_positions.clear();
 	_vertices.clear();
+	_quantizedVertices.clear();
 	_indices.clear();
 	_triangles.clear();
-	_positionBuffer.Reset();
-	_vertexBuffer.Reset();
-	_indexBuffer.Reset();
-	_triangleBuffer.Reset();
-}
-
-RenderScene Scene::Flatten() const {
-	RenderScene scene = {};
-
-	const std::function<void(const Node&)> AddNode = [&](const Node& node) {
-		if (node.Mesh && !node.Mesh->Meshlets.empty()) {
-			const auto instanceId = scene.Transforms.size();
-			scene.Transforms.emplace_back(node.GetGlobalTransform());
-			for (auto& meshlet : node.Mesh->Meshlets) {
-				meshlet.InstanceID = instanceId;
-				scene.TriangleCount += meshlet.TriangleCount;
-				scene.Meshlets.push_back(meshlet);
+	_meshlets.clear();
+	_bakedMapping.Reset();
+	if (_geometry) { Renderer::GetGeometryArena().Free(_geometry); }
+	_geometry           = {};
+	_geometryOffsets    = {};
+	_geometryGeneration = 0;
+	_vertexFormat       = VertexFormat::Float;
+	_renderScene        = nullptr;
+	_freeInstances.clear();
+	_firstStaleInstance = std::numeric_limits<uint32_t>::max();
+	_dirtyNodes.clear();
+	_transformNodes.clear();
+	_transformParents.clear();
+	_localTransforms.clear();
+	_globalTransforms.clear();
+	_transformDirty.clear();
+	_anyTransformDirty = false;
+	_instanceBvh.Clear();
+	_instanceBounds.clear();
+	_changedInstanceBounds.clear();
+	_instanceBvhDirty = false;
+	_occluders.clear();
+	_occluderTriangles.clear();
+	_anyOccluded = false;
+	_load.Reset();
+	_streamSources  = {};
+	_streamCursors  = {};
+	_meshStreamEnds.clear();
+	_residentMeshes = 0;
+	_textureData.clear();
+	_textureStreamer.Reset({});
+}
+
+void Scene::SetTransform(Node& node, const glm::mat4& transform) {
+	node.Transform = transform;
+	// Nodes loaded since the last Update() are not yet in the transform order, they pick up Node::Transform when added.
+	if (node.Index == std::numeric_limits<uint32_t>::max()) { return; }
+
+	_localTransforms[node.Index] = transform;
+	_transformDirty[node.Index]  = true;
+	_anyTransformDirty           = true;
+}
+
+void Scene::SetMesh(Node& node, Mesh* mesh) {
+	if (node.Mesh == mesh) { return; }
+
+	if (!node.MeshDirty) { _dirtyNodes.push_back(&node); }
+	node.Mesh         = mesh;
+	node.MeshDirty    = true;
+	_instanceBvhDirty = true;
+}
+
+/** Mark a range of elements as changed, extending the previous range if the two touch. */
+static void AddDirtyRange(std::vector<RenderScene::Range>& ranges, uint32_t offset, uint32_t count) {
+	if (count == 0) { return; }
+
+	if (!ranges.empty() && ranges.back().Offset + ranges.back().Count == offset) {
+		ranges.back().Count += count;
+	} else {
+		ranges.push_back({offset, count});
+	}
+}
+
+void Scene::Update(RenderScene& scene, OcclusionBuffer* occlusion) {
+	scene.DirtyInstances.clear();
+	scene.DirtyTransforms.clear();
+
+	if (_load && _load->State == SceneLoad::LoadState::Uploading && _load->Loaded) {
+		if (!BeginStreaming(*_load->Loaded)) { _load->State = SceneLoad::LoadState::Failed; }
+		_load->Loaded.reset();
+	}
+	if (_load && _load->State == SceneLoad::LoadState::Failed) { _load.Reset(); }
+	if (_geometry && Renderer::GetGeometryArena().GetGeneration() != _geometryGeneration) { RelocateGeometry(); }
+
+	if (_renderScene != &scene) {
+		RebuildRenderScene(scene);
+	} else {
+		// Instances are added and removed first, so the transform pass below sees the final instance layout.
+		for (auto* node : _dirtyNodes) {
+			RemoveInstance(scene, *node);
+			if (node->Mesh && node->Mesh->Resident && !node->Mesh->Meshlets.empty() &&
+			    node->Index != std::numeric_limits<uint32_t>::max()) {
+				AddInstance(scene, *node, _globalTransforms[node->Index]);
 			}
+			node->MeshDirty = false;
+		}
+		_dirtyNodes.clear();
+	}
+
+	if (StreamGeometry()) { AddResidentInstances(scene); }
+	StreamTextures();
+	if (_load && _load->State == SceneLoad::LoadState::Uploading && !_load->Loaded &&
+	    _residentMeshes == _meshStreamEnds.size() &&
+	    _textureStreamer.GetResidentTextureCount() == _textureStreamer.GetTextureCount()) {
+		_load->State = SceneLoad::LoadState::Complete;
+		_load.Reset();
+	}
+	PropagateTransforms(scene);
+	UpdateInstanceBvh();
+	CullOccludedInstances(scene, occlusion);
+	UpdateWorkItems(scene);
+}
+
+void Scene::BuildTransformOrder() {
+	constexpr auto NoParent = std::numeric_limits<uint32_t>::max();
+
+	_transformNodes.clear();
+	_transformParents.clear();
+	_transformNodes.reserve(_nodes.size());
+	_transformParents.reserve(_nodes.size());
+	for (auto& node : _nodes) { node.Index = NoParent; }
+
+	// Breadth-first from the roots, which places every parent before its children.
+	for (auto* root : _rootNodes) {
+		root->Index = uint32_t(_transformNodes.size());
+		_transformNodes.push_back(root);
+		_transformParents.push_back(NoParent);
+	}
+	for (size_t i = 0; i < _transformNodes.size(); ++i) {
+		for (auto* child : _transformNodes[i]->Children) {
+			child->Index = uint32_t(_transformNodes.size());
+			_transformNodes.push_back(child);
+			_transformParents.push_back(uint32_t(i));
+		}
+	}
+
+	_localTransforms.resize(_transformNodes.size());
+	for (size_t i = 0; i < _transformNodes.size(); ++i) { _localTransforms[i] = _transformNodes[i]->Transform; }
+	_globalTransforms.resize(_transformNodes.size());
+	_transformDirty.assign(_transformNodes.size(), true);
+	_anyTransformDirty = true;
+	_instanceBvhDirty  = true;
+}
+
+void Scene::PropagateTransforms(RenderScene& scene) {
+	if (!_anyTransformDirty) { return; }
+
+	constexpr auto NoParent = std::numeric_limits<uint32_t>::max();
+	const auto nodeCount    = _transformNodes.size();
+	for (size_t i = 0; i < nodeCount; ++i) {
+		// A parent always comes first, so its flag already includes any change further up the hierarchy.
+		const auto parent = _transformParents[i];
+		if (parent != NoParent) { _transformDirty[i] |= _transformDirty[parent]; }
+		if (!_transformDirty[i]) { continue; }
+
+		_globalTransforms[i] = parent == NoParent ? _localTransforms[i] : _globalTransforms[parent] * _localTransforms[i];
+		if (!_instanceBvhDirty && _transformNodes[i]->Mesh) { _changedInstanceBounds.push_back(uint32_t(i)); }
+
+		const auto instanceId = _transformNodes[i]->InstanceID;
+		if (instanceId != std::numeric_limits<uint32_t>::max()) {
+			scene.Transforms[instanceId] = _globalTransforms[i];
+			AddDirtyRange(scene.DirtyTransforms, instanceId, 1);
+		}
+	}
+
+	std::ranges::fill(_transformDirty, uint8_t(false));
+	_anyTransformDirty = false;
+}
+
+void Scene::RebuildRenderScene(RenderScene& scene) {
+	scene.Instances.clear();
+	scene.Transforms.clear();
+	scene.MeshletCount      = 0;
+	scene.TriangleCount     = 0;
+	scene.OccludedInstances = 0;
+	_renderScene            = &scene;
+	_anyOccluded            = false;
+	_freeInstances.clear();
+	_firstStaleInstance = std::numeric_limits<uint32_t>::max();
+	_dirtyNodes.clear();
+	for (auto& node : _nodes) {
+		node.InstanceID = std::numeric_limits<uint32_t>::max();
+		node.MeshDirty  = false;
+	}
+
+	BuildTransformOrder();
+	PropagateTransforms(scene);
+	// Instances are created in transform order, so a moved subtree tends to touch a contiguous range of transforms.
+	for (auto* node : _transformNodes) {
+		if (node->Mesh && node->Mesh->Resident && !node->Mesh->Meshlets.empty()) {
+			AddInstance(scene, *node, _globalTransforms[node->Index]);
+		}
+	}
+}
+
+void Scene::AddResidentInstances(RenderScene& scene) {
+	for (auto* node : _transformNodes) {
+		if (node->InstanceID == std::numeric_limits<uint32_t>::max() && node->Mesh && node->Mesh->Resident &&
+		    !node->Mesh->Meshlets.empty()) {
+			AddInstance(scene, *node, _globalTransforms[node->Index]);
 		}
+	}
+}
 
-		for (const auto* child : node.Children) { AddNode(*child); }
+void Scene::UpdateInstanceBvh() {
+	const auto GetInstanceBounds = [&](uint32_t index) {
+		const auto* mesh = _transformNodes[index]->Mesh;
+
+		return mesh ? mesh->MeshletBvh.GetBounds().Transform(_globalTransforms[index]) : BvhBounds{};
 	};
-	for (auto* node : _rootNodes) { AddNode(*node); }
+
+	if (_instanceBvhDirty) {
+		std::vector<uint32_t> instances;
+		_instanceBounds.resize(_transformNodes.size());
+		for (uint32_t i = 0; i < _transformNodes.size(); ++i) {
+			_instanceBounds[i] = GetInstanceBounds(i);
+			if (!_instanceBounds[i].Empty()) { instances.push_back(i); }
+		}
+		_instanceBvh.Build(_instanceBounds, instances, true);
+		_instanceBvhDirty = false;
+		SelectOccluders();
+	} else if (!_changedInstanceBounds.empty()) {
+		for (const auto index : _changedInstanceBounds) { _instanceBounds[index] = GetInstanceBounds(index); }
+		_instanceBvh.Refit(_instanceBounds, _changedInstanceBounds);
+	}
+	_changedInstanceBounds.clear();
+}
+
+void Scene::SelectOccluders() {
+	constexpr static size_t MaxAutoOccluders     = 32;
+	constexpr static size_t MaxOccluderTriangles = 2048;
+
+	_occluders.clear();
+	for (uint32_t i = 0; i < _transformNodes.size(); ++i) {
+		if (_transformNodes[i]->Occluder && _transformNodes[i]->Mesh) { _occluders.push_back(i); }
+	}
+	if (!_occluders.empty()) { return; }
+
+	// Without authored occluders, the largest instances are the likeliest to hide others. Detailed meshes would cost
+	// more to rasterize than they save.
+	for (uint32_t i = 0; i < _transformNodes.size(); ++i) {
+		const auto* mesh = _transformNodes[i]->Mesh;
+		if (mesh && !_instanceBounds[i].Empty() && GetOccluderTriangles(*mesh).size() / 3 <= MaxOccluderTriangles) {
+			_occluders.push_back(i);
+		}
+	}
+	const auto occluderCount = std::min(_occluders.size(), MaxAutoOccluders);
+	std::ranges::partial_sort(_occluders, _occluders.begin() + occluderCount, std::ranges::greater{}, [&](uint32_t i) {
+		return _instanceBounds[i].SurfaceArea();
+	});
+	_occluders.resize(occluderCount);
+}
+
+const std::vector<glm::vec3>& Scene::GetOccluderTriangles(const Mesh& mesh) {
+	auto [it, inserted] = _occluderTriangles.try_emplace(&mesh);
+	if (!inserted) { return it->second; }
+
+	// Only the full-detail clusters are used. Simplification may push a mesh's silhouette outwards, so a coarser cut
+	// through the DAG could cover pixels the real mesh does not, and hide what is visible through them.
+	auto& triangles = it->second;
+	for (const auto& meshlet : mesh.Meshlets) {
+		if (meshlet.LodError != 0.0f) { continue; }
+		for (uint32_t t = 0; t < meshlet.TriangleCount; ++t) {
+			for (uint32_t corner = 0; corner < 3; ++corner) { triangles.push_back(GetMeshletVertex(meshlet, t, corner)); }
+		}
+	}
+
+	return triangles;
+}
+
+glm::vec3 Scene::GetMeshletVertex(const Meshlet& meshlet, uint32_t triangle, uint32_t corner) const {
+	const auto positions = _streamSources[size_t(GeometryStream::Positions)];
+	const auto indices   = _streamSources[size_t(GeometryStream::Indices)];
+	const auto triangles = _streamSources[size_t(GeometryStream::Triangles)];
+
+	const auto local = uint8_t(triangles[meshlet.TriangleOffset + triangle * 3 + corner]);
+	uint32_t index;
+	std::memcpy(&index, indices.data() + sizeof(uint32_t) * (meshlet.IndexOffset + local), sizeof(index));
+	glm::vec3 position;
+	std::memcpy(
+		&position, positions.data() + sizeof(glm::vec3) * (uint64_t(meshlet.VertexOffset) + index), sizeof(position));
+
+	return position;
+}
+
+/** Moller-Trumbore ray-triangle intersection. Returns the distance along the ray in multiples of direction, if hit. */
+static std::optional<float> IntersectTriangle(const glm::vec3& origin,
+                                              const glm::vec3& direction,
+                                              const std::array<glm::vec3, 3>& triangle) {
+	const auto edge1        = triangle[1] - triangle[0];
+	const auto edge2        = triangle[2] - triangle[0];
+	const auto p            = glm::cross(direction, edge2);
+	const float determinant = glm::dot(edge1, p);
+	if (std::abs(determinant) < std::numeric_limits<float>::epsilon()) { return std::nullopt; }
+
+	const float inverseDeterminant = 1.0f / determinant;
+	const auto s                   = origin - triangle[0];
+	const float u                  = glm::dot(s, p) * inverseDeterminant;
+	if (u < 0.0f || u > 1.0f) { return std::nullopt; }
+
+	const auto q  = glm::cross(s, edge1);
+	const float v = glm::dot(direction, q) * inverseDeterminant;
+	if (v < 0.0f || u + v > 1.0f) { return std::nullopt; }
+
+	const float distance = glm::dot(edge2, q) * inverseDeterminant;
+	if (distance < 0.0f) { return std::nullopt; }
+
+	return distance;
+}
+
+std::optional<Scene::RaycastHit> Scene::Raycast(const glm::vec3& origin,
+                                                const glm::vec3& direction,
+                                                float maxDistance) const {
+	std::optional<RaycastHit> hit;
+	_instanceBvh.Intersect(origin, direction, maxDistance, [&](uint32_t nodeIndex, float& hitDistance) {
+		auto* node = _transformNodes[nodeIndex];
+		if (!node->Mesh) { return; }
+
+		// The ray is moved into mesh space rather than the mesh into world space. The transform is affine, so distances
+		// along the ray are the same in both.
+		const auto& mesh              = *node->Mesh;
+		const auto worldToMesh        = glm::inverse(_globalTransforms[nodeIndex]);
+		const glm::vec3 meshOrigin    = glm::vec3(worldToMesh * glm::vec4(origin, 1.0f));
+		const glm::vec3 meshDirection = glm::vec3(worldToMesh * glm::vec4(direction, 0.0f));
+		mesh.MeshletBvh.Intersect(meshOrigin, meshDirection, hitDistance, [&](uint32_t meshletIndex, float& limit) {
+			const auto& meshlet = mesh.Meshlets[meshletIndex];
+			for (uint32_t t = 0; t < meshlet.TriangleCount; ++t) {
+				const std::array<glm::vec3, 3> triangle = {
+					GetMeshletVertex(meshlet, t, 0), GetMeshletVertex(meshlet, t, 1), GetMeshletVertex(meshlet, t, 2)};
+				const auto distance = IntersectTriangle(meshOrigin, meshDirection, triangle);
+				if (distance && *distance < limit) {
+					limit = *distance;
+					hit   = RaycastHit{.Node = node, .Meshlet = meshletIndex, .Triangle = t, .Distance = *distance};
+				}
+			}
+		});
+	});
+
+	return hit;
+}
+
+void Scene::QueryFrustum(std::span<const glm::vec4, 6> planes, std::vector<Node*>& nodes) const {
+	_instanceBvh.Intersect(planes, [&](uint32_t nodeIndex) { nodes.push_back(_transformNodes[nodeIndex]); });
+}
+
+void Scene::RequestTextureMips(std::span<const glm::vec4, 6> planes,
+                               const glm::vec3& cameraPosition,
+                               float pixelsPerUnit) {
+	if (_textureStreamer.GetTextureCount() == 0) { return; }
+
+	_instanceBvh.Intersect(planes, [&](uint32_t nodeIndex) {
+		const auto* mesh = _transformNodes[nodeIndex]->Mesh;
+		if (!mesh || mesh->Textures.empty()) { return; }
+
+		// The bounding sphere's diameter at its nearest point. A camera inside the bounds needs full detail.
+		const auto& bounds   = _instanceBounds[nodeIndex];
+		const float radius   = glm::length(bounds.Max - bounds.Min) * 0.5f;
+		const float distance = glm::length(bounds.Center() - cameraPosition) - radius;
+		const float pixels   = distance > 0.0f ? 2.0f * radius * pixelsPerUnit / distance
+		                                       : std::numeric_limits<float>::max();
+		for (const auto texture : mesh->Textures) { _textureStreamer.RequestSize(texture, pixels); }
+	});
+}
+
+/** Only full-detail clusters count towards a mesh's triangles, the GPU draws one cut through the cluster DAG. */
+static uint64_t GetTriangleCount(const Mesh& mesh) {
+	uint64_t triangleCount = 0;
+	for (const auto& meshlet : mesh.Meshlets) {
+		if (meshlet.LodError == 0.0f) { triangleCount += meshlet.TriangleCount; }
+	}
+
+	return triangleCount;
+}
+
+void Scene::RemoveInstance(RenderScene& scene, Node& node) {
+	if (node.InstanceID == std::numeric_limits<uint32_t>::max()) { return; }
+
+	// The ID stays in place as an empty instance, so no other instance has to move.
+	auto& instance = scene.Instances[node.InstanceID];
+	if (instance.MeshletCount > 0) { scene.TriangleCount -= node.Triangles; }
+	instance            = {};
+	_firstStaleInstance = std::min(_firstStaleInstance, node.InstanceID);
+
+	_freeInstances.push_back(node.InstanceID);
+	node.InstanceID = std::numeric_limits<uint32_t>::max();
+}
+
+void Scene::AddInstance(RenderScene& scene, Node& node, const glm::mat4& globalTransform) {
+	uint32_t instanceId;
+	if (_freeInstances.empty()) {
+		instanceId = uint32_t(scene.Instances.size());
+		scene.Instances.emplace_back();
+		scene.Transforms.emplace_back();
+	} else {
+		instanceId = _freeInstances.back();
+		_freeInstances.pop_back();
+	}
+
+	const auto& mesh    = *node.Mesh;
+	node.InstanceID     = instanceId;
+	node.Triangles      = GetTriangleCount(mesh);
+	_firstStaleInstance = std::min(_firstStaleInstance, instanceId);
+
+	scene.Instances[instanceId]  = {.MeshletOffset = mesh.MeshletOffset, .MeshletCount = uint32_t(mesh.Meshlets.size())};
+	scene.Transforms[instanceId] = globalTransform;
+	scene.TriangleCount += node.Triangles;
+	AddDirtyRange(scene.DirtyTransforms, instanceId, 1);
+}
+
+void Scene::UpdateWorkItems(RenderScene& scene) {
+	const auto instanceCount = uint32_t(scene.Instances.size());
+	if (_firstStaleInstance >= instanceCount) {
+		_firstStaleInstance = std::numeric_limits<uint32_t>::max();
+		return;
+	}
+
+	uint32_t workItem = 0;
+	if (_firstStaleInstance > 0) {
+		const auto& previous = scene.Instances[_firstStaleInstance - 1];
+		workItem             = previous.FirstWorkItem + previous.MeshletCount;
+	}
+	for (uint32_t i = _firstStaleInstance; i < instanceCount; ++i) {
+		scene.Instances[i].FirstWorkItem = workItem;
+		workItem += scene.Instances[i].MeshletCount;
+	}
+	scene.MeshletCount = workItem;
+
+	AddDirtyRange(scene.DirtyInstances, _firstStaleInstance, instanceCount - _firstStaleInstance);
+	_firstStaleInstance = std::numeric_limits<uint32_t>::max();
+}
+
+void Scene::CullOccludedInstances(RenderScene& scene, OcclusionBuffer* occlusion) {
+	if (!occlusion && !_anyOccluded) { return; }
+
+	if (occlusion) {
+		for (const auto index : _occluders) {
+			const auto* mesh = _transformNodes[index]->Mesh;
+			if (mesh && mesh->Resident) { occlusion->RenderOccluder(GetOccluderTriangles(*mesh), _globalTransforms[index]); }
+		}
+	}
+
+	// A hidden instance keeps its ID and transform, and only gives up its meshlets, so showing it again is cheap.
+	scene.OccludedInstances = 0;
+	for (uint32_t i = 0; i < _transformNodes.size(); ++i) {
+		const auto* node = _transformNodes[i];
+		if (node->InstanceID == std::numeric_limits<uint32_t>::max()) { continue; }
+
+		const bool visible      = !occlusion || occlusion->IsVisible(_instanceBounds[i]);
+		const auto meshletCount = visible ? uint32_t(node->Mesh->Meshlets.size()) : 0u;
+		if (!visible) { ++scene.OccludedInstances; }
+
+		auto& instance = scene.Instances[node->InstanceID];
+		if (instance.MeshletCount == meshletCount) { continue; }
+		if (visible) {
+			scene.TriangleCount += node->Triangles;
+		} else {
+			scene.TriangleCount -= node->Triangles;
+		}
+		instance.MeshletCount = meshletCount;
+		_firstStaleInstance   = std::min(_firstStaleInstance, node->InstanceID);
+	}
+	_anyOccluded = scene.OccludedInstances > 0;
+}
+
+template <typename T>
+static std::span<const T> GetBakedSection(const FileMappingHandle& mapping,
+                                          const BakedSceneHeader& header,
+                                          BakedSceneSection section) {
+	const auto& info = header.Sections[size_t(section)];
+
+	return {reinterpret_cast<const T*>(mapping->Data<uint8_t>() + info.Offset), size_t(info.Size / sizeof(T))};
+}
+
+static bool ValidateBakedSection(const BakedSceneHeader& header, BakedSceneSection section, size_t elementSize) {
+	const auto& info = header.Sections[size_t(section)];
+
+	return info.Offset % BakedSceneAlignment == 0 && info.Size % elementSize == 0 && info.Offset <= header.FileSize &&
+	       info.Size <= header.FileSize - info.Offset;
+}
+
+template <typename T>
+static bool ValidateBakedSection(const BakedSceneHeader& header, BakedSceneSection section) {
+	return ValidateBakedSection(header, section, sizeof(T));
+}
+
+static uint32_t GetVertexStride(VertexFormat format) {
+	return format == VertexFormat::Quantized ? sizeof(QuantizedVertex) : sizeof(Vertex);
+}
+
+SceneLoadHandle Scene::LoadModel(const Path& modelFile) {
+	Clear();
+
+	// The loading thread reads into a Scene of its own, which Update() takes over once it is done. It is not one of
+	// the workers, as the import waits on tasks of its own which a worker would be holding up.
+	_load = MakeHandle<SceneLoad>();
+	// The device decides what textures are transcoded to, so the loading thread need not touch it.
+	const auto textureTarget = GetTextureTarget(Renderer::GetDevice());
+	const auto format        = Renderer::GetGeometryArena().GetVertexFormat();
+
+	_loadThread = std::thread([load = _load, modelFile, format, textureTarget]() {
+		auto scene            = std::make_unique<Scene>();
+		scene->_textureTarget = textureTarget;
+		if (!scene->Load(modelFile, format)) {
+			load->State = SceneLoad::LoadState::Failed;
+			return;
+		}
+
+		ImportTimer timer;
+		scene->PrepareStreaming();
+		scene->BuildMeshBvhs(timer);
+		load->MeshCount    = uint32_t(scene->_meshes.size());
+		load->TextureCount = uint32_t(scene->_textureData.size());
+		load->Loaded       = std::move(scene);
+		load->State        = SceneLoad::LoadState::Uploading;
+	});
+
+	return _load;
+}
+
+bool Scene::Load(const Path& modelFile, VertexFormat format) {
+	if (modelFile.Extension() == ".lunascene") {
+		if (!LoadBaked(modelFile, std::nullopt, format)) {
+			Log::Error("Renderer", "Failed to load baked scene '{}'", modelFile);
+			return false;
+		}
+		return true;
+	}
+
+	const Path bakedFile = Path(modelFile.ParentPath()) / (std::string(modelFile.Stem()) + ".lunascene");
+	FileStat sourceStat  = {};
+	if (!Filesystem::Stat(modelFile, sourceStat)) {
+		Log::Error("Renderer", "Failed to load model '{}': File does not exist", modelFile);
+		return false;
+	}
+
+	if (Filesystem::Exists(bakedFile)) {
+		// A baked scene holds geometry only, its textures are still read from the glTF.
+		if (LoadBaked(bakedFile, sourceStat.LastModified, format)) {
+			if (!ImportGltfTextures(modelFile)) { Log::Warning("Renderer", "Failed to load textures of '{}'", modelFile); }
+			return true;
+		}
+		Clear();
+	}
+
+	ImportTimer timer;
+	if (!ImportGltf(modelFile, format, timer)) { return false; }
+
+	if (!SaveBaked(bakedFile, sourceStat.LastModified)) {
+		Log::Warning("Renderer", "Failed to write baked scene '{}'", bakedFile);
+	}
+	PrepareImportedStreams();
+
+	return true;
+}
+
+std::unique_ptr<Scene> Scene::Import(const Path& gltfFile,
+                                     VertexFormat format,
+                                     TextureTarget textureTarget,
+                                     SceneImportStats* stats) {
+	ImportTimer timer(stats);
+	auto scene            = std::make_unique<Scene>();
+	scene->_textureTarget = textureTarget;
+	if (!scene->ImportGltf(gltfFile, format, timer)) { return nullptr; }
+
+	// The rest of what the loading thread does before handing the scene over for upload.
+	timer.Run(ImportStage::PrepareStreaming, [&]() {
+		scene->PrepareImportedStreams();
+		scene->PrepareStreaming();
+	});
+	scene->BuildMeshBvhs(timer);
+	timer.Report();
+
+	if (stats) {
+		stats->MeshCount     = uint32_t(scene->_meshes.size());
+		stats->NodeCount     = uint32_t(scene->_nodes.size());
+		stats->MeshletCount  = uint32_t(scene->_meshlets.size());
+		stats->VertexCount   = scene->_positions.size();
+		stats->IndexCount    = scene->_indices.size();
+		stats->TriangleCount = 0;
+		for (const auto& mesh : scene->_meshes) { stats->TriangleCount += GetTriangleCount(mesh); }
+		stats->TextureCount = 0;
+		stats->TextureBytes = 0;
+		for (const auto& texture : scene->_textureData) {
+			if (texture.Empty()) { continue; }
+			++stats->TextureCount;
+			stats->TextureBytes += texture.Data.size();
+		}
+	}
 
 	return scene;
 }
 
-void Scene::LoadModel(const Path& gltfFile) {
-	GltfContext context = {.GltfFile   = gltfFile,
-	                       .GltfFolder = gltfFile.ParentPath(),
-	                       .GltfAsset  = fastgltf::Asset(),
-	                       .Meshes     = _meshes,
-	                       .Nodes      = _nodes,
-	                       .RootNodes  = _rootNodes,
-	                       .Positions  = _positions,
-	                       .Attributes = _vertices,
-	                       .Indices    = _indices,
-	                       .Triangles  = _triangles};
+void Scene::PrepareImportedStreams() {
+	// Meshlets are laid out in the same order as a baked scene's Meshlets section.
+	for (auto& mesh : _meshes) {
+		mesh.MeshletOffset = uint32_t(_meshlets.size());
+		_meshlets.insert(_meshlets.end(), mesh.Meshlets.begin(), mesh.Meshlets.end());
+	}
+
+	const auto StreamArray = [&](GeometryStream stream, const auto& array) {
+		_streamSources[size_t(stream)] = std::as_bytes(std::span(array));
+	};
+	StreamArray(GeometryStream::Positions, _positions);
+	if (_vertexFormat == VertexFormat::Quantized) {
+		StreamArray(GeometryStream::Vertices, _quantizedVertices);
+	} else {
+		StreamArray(GeometryStream::Vertices, _vertices);
+	}
+	StreamArray(GeometryStream::Indices, _indices);
+	StreamArray(GeometryStream::Triangles, _triangles);
+	StreamArray(GeometryStream::Meshlets, _meshlets);
+}
+
+void Scene::PrepareStreaming() {
+	const auto indices      = _streamSources[size_t(GeometryStream::Indices)];
+	const auto vertexStride = GetVertexStride(_vertexFormat);
+
+	// Geometry is stored in mesh order, so a mesh is resident once every stream has been uploaded past its furthest
+	// element. Each end also covers the mesh before it, which keeps the ends ascending even if meshes share data.
+	GeometryStreamOffsets ends = {};
+	auto& [positionsEnd, verticesEnd, indicesEnd, trianglesEnd, meshletsEnd] = ends;
+	_meshStreamEnds.resize(_meshes.size());
+	for (size_t i = 0; i < _meshes.size(); ++i) {
+		const auto& mesh = _meshes[i];
+		for (const auto& meshlet : mesh.Meshlets) {
+			uint32_t vertexCount = 0;
+			for (uint32_t j = 0; j < meshlet.IndexCount; ++j) {
+				uint32_t index;
+				std::memcpy(&index, indices.data() + sizeof(uint32_t) * (meshlet.IndexOffset + j), sizeof(index));
+				vertexCount = std::max(vertexCount, index + 1);
+			}
+
+			const uint64_t vertexEnd = uint64_t(meshlet.VertexOffset) + vertexCount;
+			positionsEnd = std::max(positionsEnd, vertexEnd * sizeof(glm::vec3));
+			verticesEnd  = std::max(verticesEnd, vertexEnd * vertexStride);
+			indicesEnd   = std::max(indicesEnd, (uint64_t(meshlet.IndexOffset) + meshlet.IndexCount) * sizeof(uint32_t));
+			trianglesEnd = std::max(trianglesEnd, uint64_t(meshlet.TriangleOffset) + meshlet.TriangleCount * 3);
+		}
+		meshletsEnd = std::max(meshletsEnd, (uint64_t(mesh.MeshletOffset) + mesh.Meshlets.size()) * sizeof(Meshlet));
+		_meshStreamEnds[i] = ends;
+	}
+}
+
+void Scene::BuildMeshBvhs(ImportTimer& timer) {
+	// Meshes are built side by side, each on a single thread.
+	auto group = Threading::CreateTaskGroup();
+	for (auto& mesh : _meshes) {
+		group->Enqueue(timer.Wrap(ImportStage::BuildMeshBvhs, [&mesh]() {
+			std::vector<BvhBounds> bounds(mesh.Meshlets.size());
+			std::vector<uint32_t> fullDetail;
+			for (uint32_t i = 0; i < mesh.Meshlets.size(); ++i) {
+				const auto& meshlet = mesh.Meshlets[i];
+				bounds[i]           = {meshlet.AABBMin, meshlet.AABBMax};
+				if (meshlet.LodError == 0.0f) { fullDetail.push_back(i); }
+			}
+			mesh.MeshletBvh.Build(bounds, fullDetail);
+		}));
+	}
+	group->Wait();
+}
+
+bool Scene::BeginStreaming(Scene& loaded) {
+	auto& arena = Renderer::GetGeometryArena();
+	const auto& sources                     = loaded._streamSources;
+	const GeometryArena::StreamSizes counts = {
+		uint32_t(sources[size_t(GeometryStream::Positions)].size() / sizeof(glm::vec3)),
+		uint32_t(sources[size_t(GeometryStream::Indices)].size() / sizeof(uint32_t)),
+		uint32_t(sources[size_t(GeometryStream::Triangles)].size()),
+		uint32_t(sources[size_t(GeometryStream::Meshlets)].size() / sizeof(Meshlet))};
+	_geometry = arena.Allocate(counts);
+	// The space left by models unloaded earlier may be too scattered to fit this one.
+	if (!_geometry && arena.Defragment()) { _geometry = arena.Allocate(counts); }
+	if (!_geometry) {
+		Log::Error("Renderer",
+		           "Geometry arena has no room for a model with {} vertices and {} meshlets",
+		           counts[size_t(GeometryArena::Stream::Vertices)],
+		           counts[size_t(GeometryArena::Stream::Meshlets)]);
+		return false;
+	}
+	_geometryOffsets    = arena.Find(_geometry)->Offsets;
+	_geometryGeneration = arena.GetGeneration();
+
+	_meshes            = std::move(loaded._meshes);
+	_nodes             = std::move(loaded._nodes);
+	_rootNodes         = std::move(loaded._rootNodes);
+	_positions         = std::move(loaded._positions);
+	_vertices          = std::move(loaded._vertices);
+	_quantizedVertices = std::move(loaded._quantizedVertices);
+	_indices           = std::move(loaded._indices);
+	_triangles         = std::move(loaded._triangles);
+	_meshlets          = std::move(loaded._meshlets);
+	_bakedMapping      = std::move(loaded._bakedMapping);
+	_vertexFormat      = loaded._vertexFormat;
+	_streamSources     = loaded._streamSources;
+	_meshStreamEnds    = std::move(loaded._meshStreamEnds);
+	_streamCursors     = {};
+	_residentMeshes    = 0;
+	_renderScene       = nullptr;
+	_textureStreamer.Reset(std::move(loaded._textureData));
+	_occluderTriangles.clear();
+
+	for (auto& mesh : _meshes) { mesh.MeshletOffset += _geometryOffsets[size_t(GeometryArena::Stream::Meshlets)]; }
+
+	return true;
+}
+
+bool Scene::StreamGeometry() {
+	if (_residentMeshes >= _meshStreamEnds.size()) { return false; }
+
+	// Take whole meshes while they fit in this frame's budget. A mesh larger than the budget is split across frames.
+	struct Chunk {
+		GeometryStream Stream;
+		uint64_t Offset;
+		uint64_t Size;
+	};
+	std::vector<Chunk> chunks;
+	uint64_t stagingSize        = 0;
+	const auto firstNewResident = _residentMeshes;
+	while (_residentMeshes < _meshStreamEnds.size() && stagingSize < StreamingBudget) {
+		const auto& ends = _meshStreamEnds[_residentMeshes];
+		for (size_t s = 0; s < GeometryStreamCount; ++s) {
+			auto size = std::min(ends[s] - std::min(ends[s], _streamCursors[s]), StreamingBudget - stagingSize);
+			// Meshlets are rebased as they are staged, so they must not be split between frames.
+			if (GeometryStream(s) == GeometryStream::Meshlets) { size -= size % sizeof(Meshlet); }
+			if (size == 0) { continue; }
+
+			chunks.push_back({GeometryStream(s), _streamCursors[s], size});
+			_streamCursors[s] += size;
+			stagingSize += size;
+		}
+
+		bool complete = true;
+		for (size_t s = 0; s < GeometryStreamCount; ++s) { complete = complete && _streamCursors[s] >= ends[s]; }
+		if (!complete) { break; }
+
+		_meshes[_residentMeshes++].Resident = true;
+	}
+
+	if (!chunks.empty()) {
+		auto& arena  = Renderer::GetGeometryArena();
+		auto& device = Renderer::GetDevice();
+		auto staging = device.CreateBuffer(Vulkan::BufferCreateInfo(Vulkan::BufferDomain::Host, stagingSize));
+		auto cmd     = device.RequestCommandBuffer(Vulkan::CommandBufferType::AsyncTransfer, "Scene Streaming");
+
+		const std::array<Vulkan::Buffer*, GeometryStreamCount> buffers = {&arena.GetPositionBuffer(),
+		                                                                  &arena.GetVertexBuffer(),
+		                                                                  &arena.GetIndexBuffer(),
+		                                                                  &arena.GetTriangleBuffer(),
+		                                                                  &arena.GetMeshletBuffer()};
+
+		// Where this scene's ranges start in each buffer, in bytes.
+		const auto& offsets               = _geometryOffsets;
+		const GeometryStreamOffsets bases = {
+			uint64_t(offsets[size_t(GeometryArena::Stream::Vertices)]) * sizeof(glm::vec3),
+			uint64_t(offsets[size_t(GeometryArena::Stream::Vertices)]) * GetVertexStride(_vertexFormat),
+			uint64_t(offsets[size_t(GeometryArena::Stream::Indices)]) * sizeof(uint32_t),
+			uint64_t(offsets[size_t(GeometryArena::Stream::Triangles)]) * sizeof(uint8_t),
+			uint64_t(offsets[size_t(GeometryArena::Stream::Meshlets)]) * sizeof(Meshlet)};
+		std::array<std::vector<vk::BufferCopy>, GeometryStreamCount> copies;
+		uint64_t stagingOffset = 0;
+		for (const auto& chunk : chunks) {
+			if (chunk.Stream == GeometryStream::Meshlets) {
+				WriteMeshlets(*staging, stagingOffset, chunk.Offset, chunk.Size);
+			} else {
+				staging->WriteData(_streamSources[size_t(chunk.Stream)].data() + chunk.Offset, chunk.Size, stagingOffset);
+			}
+			copies[size_t(chunk.Stream)].emplace_back(stagingOffset, bases[size_t(chunk.Stream)] + chunk.Offset, chunk.Size);
+			stagingOffset += chunk.Size;
+		}
+		for (size_t s = 0; s < GeometryStreamCount; ++s) {
+			if (!copies[s].empty()) { cmd->CopyBuffer(*buffers[s], *staging, copies[s]); }
+		}
+
+		// The transfer queue runs alongside rendering, so the frame which first draws these meshes waits on it.
+		std::vector<Vulkan::SemaphoreHandle> semaphores(1);
+		device.Submit(cmd, nullptr, &semaphores);
+		device.AddWaitSemaphore(Vulkan::CommandBufferType::Generic,
+		                        semaphores[0],
+		                        vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eVertexShader,
+		                        true);
+	}
+
+	if (_load) { _load->ResidentMeshes = _residentMeshes; }
+
+	return _residentMeshes > firstNewResident;
+}
+
+void Scene::StreamTextures() {
+	if (_textureStreamer.GetTextureCount() == 0) { return; }
+
+	// Textures have a per-frame budget of the same size as the geometry's, so a load does not starve them of bandwidth.
+	_textureStreamer.Update(Renderer::GetDevice(), StreamingBudget);
+
+	if (_load) { _load->ResidentTextures = _textureStreamer.GetResidentTextureCount(); }
+}
+
+void Scene::WriteMeshlets(Vulkan::Buffer& staging, uint64_t stagingOffset, uint64_t offset, uint64_t size) const {
+	std::vector<Meshlet> meshlets(size / sizeof(Meshlet));
+	std::memcpy(meshlets.data(), _streamSources[size_t(GeometryStream::Meshlets)].data() + offset, size);
+	for (auto& meshlet : meshlets) {
+		meshlet.VertexOffset += _geometryOffsets[size_t(GeometryArena::Stream::Vertices)];
+		meshlet.IndexOffset += _geometryOffsets[size_t(GeometryArena::Stream::Indices)];
+		meshlet.TriangleOffset += _geometryOffsets[size_t(GeometryArena::Stream::Triangles)];
+	}
+	staging.WriteData(meshlets.data(), size, stagingOffset);
+}
+
+void Scene::RelocateGeometry() {
+	auto& arena             = Renderer::GetGeometryArena();
+	const auto& offsets     = arena.Find(_geometry)->Offsets;
+	const auto meshletDelta = offsets[size_t(GeometryArena::Stream::Meshlets)] -
+	                          _geometryOffsets[size_t(GeometryArena::Stream::Meshlets)];
+	for (auto& mesh : _meshes) { mesh.MeshletOffset += meshletDelta; }
+	_geometryOffsets    = offsets;
+	_geometryGeneration = arena.GetGeneration();
+	_renderScene        = nullptr;
+
+	// The arena moved the meshlets as they were, so the ones uploaded so far still refer to the old ranges.
+	const auto uploaded = _streamCursors[size_t(GeometryStream::Meshlets)];
+	if (uploaded == 0) { return; }
+
+	auto& device           = Renderer::GetDevice();
+	auto staging           = device.CreateBuffer(Vulkan::BufferCreateInfo(Vulkan::BufferDomain::Host, uploaded));
+	auto cmd               = device.RequestCommandBuffer(Vulkan::CommandBufferType::Generic, "Scene Relocation");
+	const auto meshletBase = uint64_t(_geometryOffsets[size_t(GeometryArena::Stream::Meshlets)]) * sizeof(Meshlet);
+	WriteMeshlets(*staging, 0, 0, uploaded);
+	cmd->CopyBuffer(arena.GetMeshletBuffer(), *staging, {vk::BufferCopy(0, meshletBase, uploaded)});
+	cmd->BufferBarrier(arena.GetMeshletBuffer(),
+	                   vk::PipelineStageFlagBits2::eTransfer,
+	                   vk::AccessFlagBits2::eTransferWrite,
+	                   vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eVertexShader,
+	                   vk::AccessFlagBits2::eShaderStorageRead);
+	device.Submit(cmd);
+}
+
+bool Scene::LoadBaked(const Path& bakedFile, std::optional<uint64_t> sourceModified, VertexFormat format) {
+	auto mapping = Filesystem::OpenReadOnlyMapping(bakedFile);
+	if (!mapping || mapping->GetSize() < sizeof(BakedSceneHeader)) { return false; }
+
+	BakedSceneHeader header;
+	std::memcpy(&header, mapping->Data(), sizeof(header));
+	const bool validFormat =
+		header.VertexFormat == VertexFormat::Float || header.VertexFormat == VertexFormat::Quantized;
+	if (header.Magic != BakedSceneMagic || header.Version != BakedSceneVersion || !validFormat ||
+	    header.VertexStride != GetVertexStride(header.VertexFormat) || header.MeshletStride != sizeof(Meshlet) ||
+	    header.FileSize != mapping->GetSize()) {
+		Log::Debug("Renderer", "Baked scene '{}' is from an incompatible version, ignoring it", bakedFile);
+		return false;
+	}
+	if (sourceModified.has_value() && header.SourceModified != *sourceModified) {
+		Log::Debug("Renderer", "Baked scene '{}' is out of date, ignoring it", bakedFile);
+		return false;
+	}
+	if (header.VertexFormat != format) {
+		Log::Debug("Renderer", "Baked scene '{}' uses a different vertex format, ignoring it", bakedFile);
+		return false;
+	}
+
+	const bool valid = ValidateBakedSection<glm::vec3>(header, BakedSceneSection::Positions) &&
+	                   ValidateBakedSection(header, BakedSceneSection::Vertices, header.VertexStride) &&
+	                   ValidateBakedSection<uint32_t>(header, BakedSceneSection::Indices) &&
+	                   ValidateBakedSection<uint8_t>(header, BakedSceneSection::Triangles) &&
+	                   ValidateBakedSection<Meshlet>(header, BakedSceneSection::Meshlets) &&
+	                   ValidateBakedSection<BakedMesh>(header, BakedSceneSection::Meshes) &&
+	                   ValidateBakedSection<BakedNode>(header, BakedSceneSection::Nodes) &&
+	                   ValidateBakedSection<uint32_t>(header, BakedSceneSection::NodeChildren) &&
+	                   ValidateBakedSection<uint32_t>(header, BakedSceneSection::RootNodes);
+	if (!valid) {
+		Log::Error("Renderer", "Baked scene '{}' is corrupt", bakedFile);
+		return false;
+	}
+
+	const auto meshlets     = GetBakedSection<Meshlet>(mapping, header, BakedSceneSection::Meshlets);
+	const auto meshes       = GetBakedSection<BakedMesh>(mapping, header, BakedSceneSection::Meshes);
+	const auto nodes        = GetBakedSection<BakedNode>(mapping, header, BakedSceneSection::Nodes);
+	const auto nodeChildren = GetBakedSection<uint32_t>(mapping, header, BakedSceneSection::NodeChildren);
+	const auto rootNodes    = GetBakedSection<uint32_t>(mapping, header, BakedSceneSection::RootNodes);
+	const auto indices      = GetBakedSection<uint32_t>(mapping, header, BakedSceneSection::Indices);
+	const auto triangles    = GetBakedSection<uint8_t>(mapping, header, BakedSceneSection::Triangles);
+	const auto vertexCount  = header.Sections[size_t(BakedSceneSection::Positions)].Size / sizeof(glm::vec3);
+
+	// Section contents are only trusted once every cross-reference has been bounds checked, down to each meshlet's
+	// indices and triangles, which are read on the CPU for streaming, raycasts and occluders, and on the GPU.
+	const auto ValidRange = [](uint64_t offset, uint64_t count, uint64_t size) {
+		return offset <= size && count <= size - offset;
+	};
+	const auto ValidIndex = [](uint32_t index, size_t size) {
+		return index == BakedSceneInvalidIndex || index < size;
+	};
+	const auto ValidMeshlet = [&](const Meshlet& meshlet) {
+		if (!ValidRange(meshlet.IndexOffset, meshlet.IndexCount, indices.size()) ||
+		    !ValidRange(meshlet.TriangleOffset, uint64_t(meshlet.TriangleCount) * 3, triangles.size())) {
+			return false;
+		}
+		const auto meshletIndices   = indices.subspan(meshlet.IndexOffset, meshlet.IndexCount);
+		const auto meshletTriangles = triangles.subspan(meshlet.TriangleOffset, size_t(meshlet.TriangleCount) * 3);
+
+		const auto ValidVertex = [&](uint32_t index) {
+			return ValidRange(meshlet.VertexOffset, uint64_t(index) + 1, vertexCount);
+		};
+		const auto ValidLocalIndex = [&](uint8_t local) { return local < meshlet.IndexCount; };
+
+		return std::ranges::all_of(meshletIndices, ValidVertex) && std::ranges::all_of(meshletTriangles, ValidLocalIndex);
+	};
+	const auto ValidMesh = [&](const BakedMesh& mesh) {
+		return ValidRange(mesh.MeshletOffset, mesh.MeshletCount, meshlets.size());
+	};
+	const auto ValidNode = [&](const BakedNode& node) {
+		return ValidIndex(node.Parent, nodes.size()) && ValidIndex(node.Mesh, meshes.size()) &&
+		       ValidRange(node.ChildOffset, node.ChildCount, nodeChildren.size());
+	};
+	const auto ValidNodeIndex = [&](uint32_t index) { return index < nodes.size(); };
+	const bool validVertices   = header.Sections[size_t(BakedSceneSection::Vertices)].Size / header.VertexStride ==
+	                           vertexCount;
+	const bool validReferences = validVertices && std::ranges::all_of(meshlets, ValidMeshlet) &&
+	                             std::ranges::all_of(meshes, ValidMesh) && std::ranges::all_of(nodes, ValidNode) &&
+	                             std::ranges::all_of(nodeChildren, ValidNodeIndex) &&
+	                             std::ranges::all_of(rootNodes, ValidNodeIndex);
+	if (!validReferences) {
+		Log::Error("Renderer", "Baked scene '{}' is corrupt", bakedFile);
+		return false;
+	}
+
+	// Only the scene hierarchy is rebuilt on the CPU. Geometry is uploaded straight from the mapping.
+	_meshes.resize(meshes.size());
+	for (size_t i = 0; i < meshes.size(); ++i) {
+		const auto meshMeshlets  = meshlets.subspan(meshes[i].MeshletOffset, meshes[i].MeshletCount);
+		_meshes[i].Meshlets.assign(meshMeshlets.begin(), meshMeshlets.end());
+		_meshes[i].MeshletOffset = meshes[i].MeshletOffset;
+	}
 
-	if (!ParseGltf(context)) { return; }
+	_nodes.resize(nodes.size());
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		const auto& bakedNode = nodes[i];
+		auto& node            = _nodes[i];
+		node.Transform        = bakedNode.Transform;
+		node.Parent           = bakedNode.Parent == BakedSceneInvalidIndex ? nullptr : &_nodes[bakedNode.Parent];
+		node.Mesh             = bakedNode.Mesh == BakedSceneInvalidIndex ? nullptr : &_meshes[bakedNode.Mesh];
+		node.Children.reserve(bakedNode.ChildCount);
+		for (const auto childIndex : nodeChildren.subspan(bakedNode.ChildOffset, bakedNode.ChildCount)) {
+			node.Children.push_back(&_nodes[childIndex]);
+		}
+	}
+
+	_rootNodes.reserve(rootNodes.size());
+	for (const auto rootIndex : rootNodes) { _rootNodes.push_back(&_nodes[rootIndex]); }
+
+	// Geometry is streamed to the GPU straight from the mapping, which is kept open until the Scene is cleared.
+	const auto StreamSection = [&](GeometryStream stream, BakedSceneSection section) {
+		_streamSources[size_t(stream)] = GetBakedSection<std::byte>(mapping, header, section);
+	};
+	StreamSection(GeometryStream::Positions, BakedSceneSection::Positions);
+	StreamSection(GeometryStream::Vertices, BakedSceneSection::Vertices);
+	StreamSection(GeometryStream::Indices, BakedSceneSection::Indices);
+	StreamSection(GeometryStream::Triangles, BakedSceneSection::Triangles);
+	StreamSection(GeometryStream::Meshlets, BakedSceneSection::Meshlets);
+	_bakedMapping = mapping;
+	_vertexFormat = header.VertexFormat;
+
+	Log::Debug("Renderer", "Loaded baked scene '{}'", bakedFile);
+
+	return true;
+}
+
+bool Scene::SaveBaked(const Path& bakedFile, uint64_t sourceModified) const {
+	std::vector<BakedMesh> meshes;
+	std::vector<Meshlet> meshlets;
+	meshes.reserve(_meshes.size());
+	for (const auto& mesh : _meshes) {
+		meshes.push_back({uint32_t(meshlets.size()), uint32_t(mesh.Meshlets.size())});
+		meshlets.insert(meshlets.end(), mesh.Meshlets.begin(), mesh.Meshlets.end());
+	}
+
+	std::vector<BakedNode> nodes;
+	std::vector<uint32_t> nodeChildren;
+	nodes.reserve(_nodes.size());
+	for (const auto& node : _nodes) {
+		nodes.push_back({.Transform   = node.Transform,
+		                 .Parent      = node.Parent ? uint32_t(node.Parent - _nodes.data()) : BakedSceneInvalidIndex,
+		                 .Mesh        = node.Mesh ? uint32_t(node.Mesh - _meshes.data()) : BakedSceneInvalidIndex,
+		                 .ChildOffset = uint32_t(nodeChildren.size()),
+		                 .ChildCount  = uint32_t(node.Children.size())});
+		for (const auto* child : node.Children) { nodeChildren.push_back(uint32_t(child - _nodes.data())); }
+	}
+
+	std::vector<uint32_t> rootNodes;
+	rootNodes.reserve(_rootNodes.size());
+	for (const auto* node : _rootNodes) { rootNodes.push_back(uint32_t(node - _nodes.data())); }
+
+	const std::array<std::span<const std::byte>, BakedSceneSectionCount> sectionData = {
+		std::as_bytes(std::span(_positions)),
+		_vertexFormat == VertexFormat::Quantized ? std::as_bytes(std::span(_quantizedVertices))
+		                                         : std::as_bytes(std::span(_vertices)),
+		std::as_bytes(std::span(_indices)),
+		std::as_bytes(std::span(_triangles)),
+		std::as_bytes(std::span(meshlets)),
+		std::as_bytes(std::span(meshes)),
+		std::as_bytes(std::span(nodes)),
+		std::as_bytes(std::span(nodeChildren)),
+		std::as_bytes(std::span(rootNodes))};
+
+	BakedSceneHeader header = {.Magic          = BakedSceneMagic,
+	                           .Version        = BakedSceneVersion,
+	                           .VertexStride   = GetVertexStride(_vertexFormat),
+	                           .MeshletStride  = sizeof(Meshlet),
+	                           .VertexFormat   = _vertexFormat,
+	                           .Reserved       = 0,
+	                           .SourceModified = sourceModified,
+	                           .FileSize       = 0,
+	                           .Sections       = {}};
+	uint64_t offset = sizeof(BakedSceneHeader);
+	for (size_t i = 0; i < BakedSceneSectionCount; ++i) {
+		offset             = (offset + BakedSceneAlignment - 1) & ~(BakedSceneAlignment - 1);
+		header.Sections[i] = {offset, sectionData[i].size()};
+		offset += sectionData[i].size();
+	}
+	header.FileSize = offset;
+
+	auto mapping = Filesystem::OpenTransactionalMapping(bakedFile, header.FileSize);
+	if (!mapping) { return false; }
+
+	auto* data = mapping->MutableData<uint8_t>();
+	std::memset(data, 0, header.FileSize);
+	std::memcpy(data, &header, sizeof(header));
+	for (size_t i = 0; i < BakedSceneSectionCount; ++i) {
+		if (!sectionData[i].empty()) {
+			std::memcpy(data + header.Sections[i].Offset, sectionData[i].data(), sectionData[i].size());
+		}
+	}
+
+	return true;
+}
+
+bool Scene::ImportGltf(const Path& gltfFile, VertexFormat format, ImportTimer& timer) {
+	GltfContext context = {.GltfFile            = gltfFile,
+	                       .GltfFolder          = gltfFile.ParentPath(),
+	                       .GltfAsset           = fastgltf::Asset(),
+	                       .Format              = format,
+	                       .Meshes              = _meshes,
+	                       .Nodes               = _nodes,
+	                       .RootNodes           = _rootNodes,
+	                       .Positions           = _positions,
+	                       .Attributes          = _vertices,
+	                       .QuantizedAttributes = _quantizedVertices,
+	                       .Indices             = _indices,
+	                       .Triangles           = _triangles};
+
+	bool parsed = false;
+	timer.Run(ImportStage::Parse, [&]() { parsed = ParseGltf(context); });
+	if (!parsed) { return false; }
+	_vertexFormat = format;
 	const auto& gltfAsset = context.GltfAsset;
 
+	// Textures need nothing from the mesh pipeline, so they are transcoded alongside it rather than as one of its stages.
+	auto textures = Threading::CreateTaskGroup();
+	EnqueueTextureLoads(gltfAsset, context.GltfFolder, _textureTarget, _textureData, *textures, timer);
+	textures->Flush();
+
+	// Meshes are split into primitives, and large primitives into ranges, which each get their own task. This keeps
+	// every worker busy even when a single mesh makes up most of the scene.
+	for (size_t i = 0; i < gltfAsset.meshes.size(); ++i) { PlanMesh(context, i); }
+
 	TaskComposer composer;
 
 	auto& buffers = composer.BeginPipelineStage();
 	for (size_t i = 0; i < gltfAsset.buffers.size(); ++i) {
-		buffers.Enqueue([&context, i]() { LoadBuffer(context, i); });
+		buffers.Enqueue(timer.Wrap(ImportStage::LoadBuffers, [&context, i]() { LoadBuffer(context, i); }));
 	}
-
-	auto& others = composer.BeginPipelineStage();
 	for (size_t i = 0; i < gltfAsset.meshes.size(); ++i) {
-		others.Enqueue([&context, i]() { LoadMesh(context, i); });
+		buffers.Enqueue(timer.Wrap(ImportStage::LoadBuffers, [&context, i]() { AllocatePrimitives(context, i); }));
+	}
+
+	auto& decode = composer.BeginPipelineStage();
+	for (size_t m = 0; m < context.RawMeshes.size(); ++m) {
+		for (size_t p = 0; p < context.RawMeshes[m].Primitives.size(); ++p) {
+			const auto& primitive = context.RawMeshes[m].Primitives[p];
+			for (size_t first = 0; first < primitive.VertexCount; first += DecodeRangeSize) {
+				const auto count = std::min(DecodeRangeSize, primitive.VertexCount - first);
+				decode.Enqueue(timer.Wrap(ImportStage::Decode, [&context, m, p, first, count]() {
+					DecodeVertices(context, m, p, first, count);
+				}));
+			}
+			for (size_t first = 0; first < primitive.IndexCount; first += DecodeRangeSize) {
+				const auto count = std::min(DecodeRangeSize, primitive.IndexCount - first);
+				decode.Enqueue(timer.Wrap(ImportStage::Decode, [&context, m, p, first, count]() {
+					DecodeIndices(context, m, p, first, count);
+				}));
+			}
+		}
 	}
 	for (size_t i = 0; i < gltfAsset.nodes.size(); ++i) {
-		others.Enqueue([&context, i]() { LoadNode(context, i); });
+		decode.Enqueue(timer.Wrap(ImportStage::Decode, [&context, i]() { LoadNode(context, i); }));
+	}
+
+	auto& process = composer.BeginPipelineStage();
+	for (size_t m = 0; m < context.RawMeshes.size(); ++m) {
+		for (size_t p = 0; p < context.RawMeshes[m].Primitives.size(); ++p) {
+			for (size_t r = 0; r < context.RawMeshes[m].Primitives[p].Ranges.size(); ++r) {
+				process.Enqueue(timer.Wrap(ImportStage::ProcessPrimitives,
+				                           [&context, m, p, r]() { ProcessPrimitiveRange(context, m, p, r); }));
+			}
+		}
+	}
+
+	auto& allocate = composer.BeginPipelineStage();
+	for (size_t m = 0; m < context.RawMeshes.size(); ++m) {
+		allocate.Enqueue(timer.Wrap(ImportStage::AllocateMeshes, [&context, m]() { AllocateMesh(context, m); }));
+	}
+
+	auto& merge = composer.BeginPipelineStage();
+	for (size_t m = 0; m < context.RawMeshes.size(); ++m) {
+		for (size_t p = 0; p < context.RawMeshes[m].Primitives.size(); ++p) {
+			for (size_t r = 0; r < context.RawMeshes[m].Primitives[p].Ranges.size(); ++r) {
+				merge.Enqueue(timer.Wrap(ImportStage::MergePrimitives,
+				                         [&context, m, p, r]() { MergePrimitiveRange(context, m, p, r); }));
+			}
+		}
 	}
 
 	auto& meshlets = composer.BeginPipelineStage();
 	for (size_t i = 0; i < gltfAsset.meshes.size(); ++i) {
-		meshlets.Enqueue([&context, i]() { BuildMeshlets(context, i); });
+		meshlets.Enqueue(timer.Wrap(ImportStage::BuildMeshlets, [&context, i]() { BuildMeshlets(context, i); }));
 	}
 
-	auto& meshletCombine = composer.BeginPipelineStage();
-	meshletCombine.Enqueue([&context]() { CombineMeshlets(context); });
+	auto& combineAllocate = composer.BeginPipelineStage();
+	combineAllocate.Enqueue(timer.Wrap(ImportStage::CombineMeshlets, [&context]() { AllocateCombinedMeshes(context); }));
+
+	auto& combine = composer.BeginPipelineStage();
+	for (size_t i = 0; i < gltfAsset.meshes.size(); ++i) {
+		combine.Enqueue(timer.Wrap(ImportStage::CombineMeshlets, [&context, i]() { CombineMeshlets(context, i); }));
+	}
 
 	composer.GetOutgoingTask()->Wait();
+	textures->Wait();
+	AssignMeshTextures(gltfAsset, _meshes);
 
-	Vulkan::BufferCreateInfo positionCI(Vulkan::BufferDomain::Device, sizeof(glm::vec3) * _positions.size());
-	_positionBuffer = Renderer::GetDevice().CreateBuffer(positionCI, _positions.data());
+	return true;
+}
 
-	Vulkan::BufferCreateInfo vertexCI(Vulkan::BufferDomain::Device, sizeof(Vertex) * _vertices.size());
-	_vertexBuffer = Renderer::GetDevice().CreateBuffer(vertexCI, _vertices.data());
+bool Scene::ImportGltfTextures(const Path& gltfFile) {
+	fastgltf::GltfDataBuffer gltfData;
+	fastgltf::Asset gltfAsset;
+	if (!ParseGltfFile(gltfFile, gltfData, gltfAsset)) { return false; }
 
-	Vulkan::BufferCreateInfo indexCI(Vulkan::BufferDomain::Device, sizeof(uint32_t) * _indices.size());
-	_indexBuffer = Renderer::GetDevice().CreateBuffer(indexCI, _indices.data());
+	const Path gltfFolder = gltfFile.ParentPath();
+	auto textures         = Threading::CreateTaskGroup();
+	ImportTimer timer;
+	EnqueueTextureLoads(gltfAsset, gltfFolder, _textureTarget, _textureData, *textures, timer);
+	textures->Wait();
+	AssignMeshTextures(gltfAsset, _meshes);
 
-	Vulkan::BufferCreateInfo triangleCI(Vulkan::BufferDomain::Device, sizeof(uint8_t) * _triangles.size());
-	_triangleBuffer = Renderer::GetDevice().CreateBuffer(triangleCI, _triangles.data());
+	return true;
 }
 
 bool Scene::ParseGltf(GltfContext& context) {
-	fastgltf::Parser parser(fastgltf::Extensions::KHR_texture_basisu);
-
-	// Load glTF/glb file.
-	fastgltf::GltfDataBuffer gltfDataBuffer;
-	{
-		auto gltfFile = Filesystem::OpenReadOnlyMapping(context.GltfFile);
-		gltfDataBuffer.copyBytes(gltfFile->Data<uint8_t>(), gltfFile->GetSize());
-	}
-
-	// Parse file into glTF asset.
-	{
-		const auto gltfFileType = fastgltf::determineGltfFileType(&gltfDataBuffer);
-		if (gltfFileType == fastgltf::GltfType::glTF) {
-			auto asset = parser.loadGLTF(&gltfDataBuffer, "", fastgltf::Options::None);
-			if (asset.error() != fastgltf::Error::None) {
-				Log::Error("Renderer", "Failed to load glTF: {}", fastgltf::getErrorMessage(asset.error()));
-				return false;
-			}
-			context.GltfAsset = std::move(asset.get());
-		} else {
-			auto asset = parser.loadBinaryGLTF(&gltfDataBuffer, "", fastgltf::Options::LoadGLBBuffers);
-			if (asset.error() != fastgltf::Error::None) {
-				Log::Error("Renderer", "Failed to load glb: {}", fastgltf::getErrorMessage(asset.error()));
-				return false;
-			}
-			context.GltfAsset = std::move(asset.get());
-		}
-	}
+	if (!ParseGltfFile(context.GltfFile, context.GltfData, context.GltfAsset)) { return false; }
 
 	context.Buffers.resize(context.GltfAsset.buffers.size());
 	context.Meshes.resize(context.GltfAsset.meshes.size());
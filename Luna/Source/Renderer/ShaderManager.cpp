@@ -3,6 +3,7 @@
 #include <Luna/Renderer/Renderer.hpp>
 #include <Luna/Renderer/ShaderCompiler.hpp>
 #include <Luna/Renderer/ShaderManager.hpp>
+#include <Luna/Utility/InternedPath.hpp>
 #include <Luna/Vulkan/Device.hpp>
 #include <Luna/Vulkan/Shader.hpp>
 
@@ -31,9 +32,9 @@ static struct ShaderManagerState {
 	Vulkan::VulkanCache<ShaderTemplate> Shaders;
 	Vulkan::VulkanCache<ShaderProgram> Programs;
 	std::vector<Path> IncludeDirs;
-	std::unordered_map<Path, std::unordered_set<ShaderTemplate*>> Dependees;
+	std::unordered_map<InternedPath, std::unordered_set<ShaderTemplate*>> Dependees;
 	std::mutex DependencyLock;
-	std::unordered_map<Path, Notify> DirectoryWatches;
+	std::unordered_map<InternedPath, Notify> DirectoryWatches;
 } State;
 
 static ShaderTemplate* GetTemplate(const Path& path, Vulkan::ShaderStage stage);
@@ -91,9 +92,10 @@ static void RegisterDependency(ShaderTemplate* shader, const Path& dependency) {
 }
 
 static void RegisterDependencyNoLock(ShaderTemplate* shader, const Path& dependency) {
-	State.Dependees[dependency].insert(shader);
+	const InternedPath interned(dependency);
+	State.Dependees[interned].insert(shader);
 
-	const Path baseDir = dependency.ParentPath();
+	const InternedPath baseDir = interned.ParentPath();
 	if (State.DirectoryWatches.find(baseDir) != State.DirectoryWatches.end()) { return; }
 
 	auto* backend = Filesystem::GetBackend(baseDir.Protocol());
@@ -0,0 +1,133 @@
+#include <ktx.h>
+
+#include <Luna/Core/Filesystem.hpp>
+#include <Luna/Renderer/Texture.hpp>
+#include <Luna/Vulkan/Device.hpp>
+
+namespace Luna {
+struct KtxTextureDeleter {
+	void operator()(ktxTexture2* texture) {
+		ktxTexture_Destroy(ktxTexture(texture));
+	}
+};
+using KtxTextureHandle = std::unique_ptr<ktxTexture2, KtxTextureDeleter>;
+
+static ktx_transcode_fmt_e GetTranscodeFormat(TextureTarget target, uint32_t components) {
+	switch (target) {
+		case TextureTarget::BC:
+			if (components == 1) { return KTX_TTF_BC4_R; }
+			if (components == 2) { return KTX_TTF_BC5_RG; }
+			return KTX_TTF_BC7_RGBA;
+		case TextureTarget::ASTC:
+			return KTX_TTF_ASTC_4x4_RGBA;
+		default:
+			return KTX_TTF_RGBA32;
+	}
+}
+
+static KTX_error_code TranscodeBasis(ktxTexture2* texture, ktx_transcode_fmt_e format) {
+	// The transcoder builds its lookup tables on first use, which is not safe to do from several threads at once. The
+	// first transcode is made alone, every one after runs freely.
+	static std::mutex InitMutex;
+	static std::atomic_bool Initialized = false;
+	if (Initialized.load(std::memory_order_acquire)) { return ktxTexture2_TranscodeBasis(texture, format, 0); }
+
+	std::lock_guard<std::mutex> lock(InitMutex);
+	const auto result = ktxTexture2_TranscodeBasis(texture, format, 0);
+	Initialized.store(true, std::memory_order_release);
+
+	return result;
+}
+
+TextureTarget GetTextureTarget(const Vulkan::Device& device) {
+	const auto& features   = device.GetDeviceInfo().EnabledFeatures.Core;
+	constexpr auto Sampled = vk::FormatFeatureFlagBits::eSampledImage;
+	if (features.textureCompressionBC &&
+	    device.IsFormatSupported(vk::Format::eBc7UnormBlock, Sampled, vk::ImageTiling::eOptimal)) {
+		return TextureTarget::BC;
+	}
+	if (features.textureCompressionASTC_LDR &&
+	    device.IsFormatSupported(vk::Format::eAstc4x4UnormBlock, Sampled, vk::ImageTiling::eOptimal)) {
+		return TextureTarget::ASTC;
+	}
+
+	return TextureTarget::Uncompressed;
+}
+
+std::optional<TextureData> LoadKtx2(std::span<const uint8_t> file, TextureTarget target, std::string_view name) {
+	KtxTextureHandle texture;
+	{
+		ktxTexture2* created = nullptr;
+		const auto result    = ktxTexture2_CreateFromMemory(
+			file.data(), file.size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &created);
+		if (result != KTX_SUCCESS) {
+			Log::Error("Renderer", "Failed to read KTX2 texture '{}': {}", name, ktxErrorString(result));
+			return std::nullopt;
+		}
+		texture.reset(created);
+	}
+
+	if (texture->numDimensions != 2 || texture->numLayers != 1 || texture->numFaces != 1) {
+		Log::Error("Renderer", "Failed to read KTX2 texture '{}': Only 2D textures are supported", name);
+		return std::nullopt;
+	}
+
+	if (ktxTexture2_NeedsTranscoding(texture.get())) {
+		const auto format = GetTranscodeFormat(target, ktxTexture2_GetNumComponents(texture.get()));
+		const auto result = TranscodeBasis(texture.get(), format);
+		if (result != KTX_SUCCESS) {
+			Log::Error("Renderer", "Failed to transcode KTX2 texture '{}': {}", name, ktxErrorString(result));
+			return std::nullopt;
+		}
+	}
+
+	TextureData data;
+	data.Format = vk::Format(texture->vkFormat);
+	if (data.Format == vk::Format::eUndefined) {
+		Log::Error("Renderer", "Failed to read KTX2 texture '{}': Texture has no Vulkan format", name);
+		return std::nullopt;
+	}
+
+	auto* base        = ktxTexture(texture.get());
+	const auto* bytes = ktxTexture_GetData(base);
+	data.Data.assign(bytes, bytes + ktxTexture_GetDataSize(base));
+	data.Mips.resize(texture->numLevels);
+	for (uint32_t level = 0; level < texture->numLevels; ++level) {
+		auto& mip  = data.Mips[level];
+		mip.Width  = std::max(texture->baseWidth >> level, 1u);
+		mip.Height = std::max(texture->baseHeight >> level, 1u);
+		mip.Size   = ktxTexture_GetImageSize(base, level);
+		ktx_size_t offset;
+		ktxTexture_GetImageOffset(base, level, 0, 0, &offset);
+		mip.Offset = offset;
+	}
+
+	return data;
+}
+
+std::optional<TextureData> LoadKtx2(const Path& path, TextureTarget target) {
+	auto file = Filesystem::OpenReadOnlyMapping(path);
+	if (!file) {
+		Log::Error("Renderer", "Failed to open KTX2 texture '{}'", path);
+		return std::nullopt;
+	}
+
+	return LoadKtx2({file->Data<uint8_t>(), file->GetSize()}, target, path.String());
+}
+
+Vulkan::ImageHandle CreateTextureImage(Vulkan::Device& device,
+                                       const TextureData& texture,
+                                       uint32_t firstMip,
+                                       const std::string& debugName) {
+	const auto mips = std::span(texture.Mips).subspan(firstMip);
+	std::vector<Vulkan::ImageInitialData> initialData;
+	initialData.reserve(mips.size());
+	for (const auto& mip : mips) { initialData.emplace_back(texture.Data.data() + mip.Offset); }
+
+	const auto imageCI =
+		Vulkan::ImageCreateInfo::Immutable2D(texture.Format, mips[0].Width, mips[0].Height)
+			.SetMipLevels(uint32_t(mips.size()));
+
+	return device.CreateImage(imageCI, initialData.data(), debugName);
+}
+}  // namespace Luna
@@ -0,0 +1,164 @@
+#include <Luna/Renderer/TextureStreamer.hpp>
+#include <Luna/Vulkan/Device.hpp>
+
+namespace Luna {
+void TextureStreamer::Reset(std::vector<TextureData> textures) {
+	_textures.clear();
+	_textures.resize(textures.size());
+	for (size_t i = 0; i < textures.size(); ++i) {
+		auto& texture     = _textures[i];
+		texture.Data      = std::move(textures[i]);
+		const auto& mips  = texture.Data.Mips;
+		const auto levels = uint32_t(mips.size());
+		texture.TailMip   = 0;
+		while (texture.TailMip + 1 < levels &&
+		       std::max(mips[texture.TailMip].Width, mips[texture.TailMip].Height) > TailSize) {
+			++texture.TailMip;
+		}
+		texture.ResidentMip  = levels;
+		texture.RequestedMip = texture.TailMip;
+	}
+	// The previous images are released along with their handles, but live on until the frames using them complete.
+	_images           = std::vector<Vulkan::ImageHandle>(_textures.size());
+	_residentTextures = 0;
+	_unassignedBytes += _residentBytes;
+	_retiringBytes += _residentBytes;
+	_residentBytes = 0;
+}
+
+void TextureStreamer::RequestMip(uint32_t texture, uint32_t mip) {
+	if (texture >= _textures.size()) { return; }
+
+	auto& streamed        = _textures[texture];
+	streamed.RequestedMip = std::min(streamed.RequestedMip, mip);
+}
+
+void TextureStreamer::RequestSize(uint32_t texture, float pixels) {
+	if (texture >= _textures.size()) { return; }
+
+	const auto& mips = _textures[texture].Data.Mips;
+	uint32_t mip     = 0;
+	while (mip + 1 < mips.size() && float(std::max(mips[mip + 1].Width, mips[mip + 1].Height)) >= pixels) { ++mip; }
+	RequestMip(texture, mip);
+}
+
+void TextureStreamer::Update(Vulkan::Device& device, uint64_t uploadBudget) {
+	if (_textures.empty()) { return; }
+
+	// Images replaced while this frame context was last in use have been destroyed by the time it comes around again.
+	const auto frameIndex = device.GetFrameIndex();
+	if (_retiringByFrame.size() != device.GetFramesInFlight()) {
+		_retiringByFrame.assign(device.GetFramesInFlight(), 0);
+		_unassignedBytes = _retiringBytes;
+	}
+	_retiringBytes -= _retiringByFrame[frameIndex];
+	_retiringByFrame[frameIndex] = _unassignedBytes;
+	_unassignedBytes             = 0;
+
+	// Textures may grow into whatever part of the budget everything else leaves free.
+	const auto memory     = device.GetMemoryBudget();
+	const auto usable     = uint64_t(double(memory.Budget) * BudgetFraction);
+	const auto otherUsage = memory.Usage - std::min<uint64_t>(memory.Usage, _residentBytes + _retiringBytes);
+	_budgetBytes          = usable - std::min(usable, otherUsage);
+	uint64_t uploaded     = 0;
+
+	// Every texture gets its mip tail before any gets more, so the whole scene can be drawn textured as soon as possible.
+	while (_residentTextures < _textures.size() && uploaded < uploadBudget) {
+		const auto& texture = _textures[_residentTextures];
+		if (!texture.Data.Empty()) { uploaded += SetResidentMip(device, _residentTextures, texture.TailMip); }
+		++_residentTextures;
+	}
+
+	std::vector<uint32_t> raise;
+	for (uint32_t i = 0; i < _residentTextures; ++i) {
+		if (_textures[i].RequestedMip < _textures[i].ResidentMip) { raise.push_back(i); }
+	}
+	std::ranges::sort(raise, std::greater{}, [&](uint32_t i) {
+		return _textures[i].ResidentMip - _textures[i].RequestedMip;
+	});
+	for (const auto i : raise) {
+		if (uploaded >= uploadBudget) { break; }
+
+		const auto& texture = _textures[i];
+		const auto mip      = texture.ResidentMip - 1;
+		const auto bytes    = GetLevelBytes(texture, mip);
+		if (!MakeRoom(device, bytes - texture.ResidentBytes, false, uploadBudget, uploaded)) { break; }
+		// Until the old image is destroyed, both are allocated.
+		if (_residentBytes + _retiringBytes + bytes > _budgetBytes) { break; }
+		uploaded += SetResidentMip(device, i, mip);
+	}
+
+	// The budget moves with everything else the process and the system allocate, and may have shrunk below what is
+	// already resident. Shrinking textures uploads their smaller images too, so this may take several frames.
+	MakeRoom(device, 0, true, uploadBudget, uploaded);
+
+	for (auto& texture : _textures) { texture.RequestedMip = texture.TailMip; }
+}
+
+uint64_t TextureStreamer::GetLevelBytes(const StreamedTexture& texture, uint32_t firstMip) {
+	uint64_t bytes = 0;
+	for (size_t level = firstMip; level < texture.Data.Mips.size(); ++level) { bytes += texture.Data.Mips[level].Size; }
+
+	return bytes;
+}
+
+uint64_t TextureStreamer::SetResidentMip(Vulkan::Device& device, uint32_t texture, uint32_t firstMip) {
+	auto& streamed = _textures[texture];
+	// The previous image may still be read by frames in flight. The device holds on to it until they complete, and
+	// its memory is counted until then.
+	_images[texture] =
+		CreateTextureImage(device, streamed.Data, firstMip, std::format("Streamed Texture {} (Mip {})", texture, firstMip));
+	_retiringByFrame[device.GetFrameIndex()] += streamed.ResidentBytes;
+	_retiringBytes += streamed.ResidentBytes;
+
+	const auto bytes       = GetLevelBytes(streamed, firstMip);
+	_residentBytes         = _residentBytes - streamed.ResidentBytes + bytes;
+	streamed.ResidentMip   = firstMip;
+	streamed.ResidentBytes = bytes;
+
+	return bytes;
+}
+
+bool TextureStreamer::MakeRoom(
+	Vulkan::Device& device, uint64_t bytes, bool force, uint64_t uploadBudget, uint64_t& uploaded) {
+	// Evicting replaces an image with a smaller one, which only frees memory once the larger one is destroyed. Eviction
+	// therefore stops once the resident images would fit, rather than waiting for the memory to be returned.
+	if (_residentBytes + bytes <= _budgetBytes) { return true; }
+
+	// Detail nobody asked for this frame goes first, from the textures holding the most of it.
+	std::vector<uint32_t> surplus;
+	for (uint32_t i = 0; i < _residentTextures; ++i) {
+		if (_textures[i].ResidentMip < _textures[i].RequestedMip) { surplus.push_back(i); }
+	}
+	std::ranges::sort(surplus, std::greater{}, [&](uint32_t i) {
+		return _textures[i].ResidentBytes - GetLevelBytes(_textures[i], _textures[i].RequestedMip);
+	});
+	for (const auto i : surplus) {
+		if (uploaded >= uploadBudget) { return false; }
+
+		uploaded += SetResidentMip(device, i, _textures[i].RequestedMip);
+		if (_residentBytes + bytes <= _budgetBytes) { return true; }
+	}
+	if (!force) { return false; }
+
+	// Then the largest textures give up a level at a time, down to their mip tails.
+	while (_residentBytes + bytes > _budgetBytes) {
+		if (uploaded >= uploadBudget) { return false; }
+
+		uint32_t largest = std::numeric_limits<uint32_t>::max();
+		for (uint32_t i = 0; i < _residentTextures; ++i) {
+			const auto& texture = _textures[i];
+			if (texture.ResidentMip >= texture.TailMip) { continue; }
+			if (largest == std::numeric_limits<uint32_t>::max() ||
+			    texture.ResidentBytes > _textures[largest].ResidentBytes) {
+				largest = i;
+			}
+		}
+		if (largest == std::numeric_limits<uint32_t>::max()) { return false; }
+
+		uploaded += SetResidentMip(device, largest, _textures[largest].ResidentMip + 1);
+	}
+
+	return true;
+}
+}  // namespace Luna
@@ -0,0 +1,178 @@
+#include <Luna/Utility/InternedPath.hpp>
+#include <Luna/Utility/IntrusiveHashMap.hpp>
+
+namespace Luna {
+struct InternedPathEntry : IntrusiveHashMapEnabled<InternedPathEntry> {
+	InternedPathEntry(const std::string& path, Hash hash) : Path(path), PathHash(hash) {
+		const auto protocolEnd = Path.find("://");
+		FilePathOffset         = protocolEnd == std::string::npos ? 0 : uint32_t(protocolEnd + 3);
+
+		const auto lastSlash = Path.find_last_of('/');
+		FilenameOffset = (lastSlash == std::string::npos || lastSlash < FilePathOffset) ? FilePathOffset
+		                                                                                 : uint32_t(lastSlash + 1);
+
+		const auto lastDot = Path.find_last_of('.');
+		ExtensionOffset =
+			(lastDot == std::string::npos || lastDot < FilenameOffset) ? uint32_t(Path.size()) : uint32_t(lastDot);
+	}
+
+	std::string Path;
+	Hash PathHash;
+	uint32_t FilePathOffset;
+	uint32_t FilenameOffset;
+	uint32_t ExtensionOffset;
+};
+
+// The table is split into shards selected by the top bits of the hash, so threads interning unrelated paths rarely
+// contend on the same lock.
+constexpr static size_t InternTableShardBits  = 4;
+constexpr static size_t InternTableShardCount = 1 << InternTableShardBits;
+
+struct InternTable {
+	std::array<ThreadSafeIntrusiveHashMap<InternedPathEntry>, InternTableShardCount> Shards;
+};
+
+static InternTable& GetInternTable() {
+	// Entries must outlive every InternedPath, including those held by other static objects, so the table is never
+	// destroyed.
+	static InternTable* table = new InternTable();
+
+	return *table;
+}
+
+static Hash HashPath(std::string_view path) {
+	Hasher h;
+	h.Data(path.size(), path.data());
+	h(path.size());
+
+	return h.Get();
+}
+
+/**
+ * Normalize the given path string into the output string.
+ *
+ * Backslashes become forward slashes, empty and "." elements are removed, and ".." elements consume their parent where
+ * one exists. The protocol and any leading root slash are preserved. The output string is reused to avoid allocating
+ * on every lookup.
+ */
+static void NormalizePath(std::string_view pathStr, std::string& out) {
+	out.clear();
+
+	const auto protocolEnd = pathStr.find("://");
+	if (protocolEnd != std::string_view::npos) {
+		out.append(pathStr.substr(0, protocolEnd + 3));
+		pathStr.remove_prefix(protocolEnd + 3);
+	}
+
+	const bool absolute = !pathStr.empty() && (pathStr.front() == '/' || pathStr.front() == '\\');
+	if (absolute) { out.push_back('/'); }
+	const size_t base = out.size();
+
+	size_t start = 0;
+	while (start <= pathStr.size()) {
+		auto end = pathStr.find_first_of("/\\", start);
+		if (end == std::string_view::npos) { end = pathStr.size(); }
+		const auto element = pathStr.substr(start, end - start);
+		start              = end + 1;
+
+		if (element.empty() || element == ".") { continue; }
+
+		if (element == "..") {
+			const std::string_view current(out.data() + base, out.size() - base);
+			const auto lastSlash = current.find_last_of('/');
+			const auto last      = lastSlash == std::string_view::npos ? current : current.substr(lastSlash + 1);
+			if (!current.empty() && last != "..") {
+				out.resize(lastSlash == std::string_view::npos ? base : base + lastSlash);
+				continue;
+			}
+
+			// Nothing left to consume. An absolute path cannot go above its root, but a relative one must keep the
+			// reference so bounds validation can still reject it.
+			if (absolute) { continue; }
+		}
+
+		if (out.size() > base) { out.push_back('/'); }
+		out.append(element);
+	}
+}
+
+static const InternedPathEntry* Intern(std::string_view pathStr) {
+	thread_local std::string normalized;
+	NormalizePath(pathStr, normalized);
+
+	const auto hash = HashPath(normalized);
+	auto& shard     = GetInternTable().Shards[hash >> (64 - InternTableShardBits)];
+
+	// Distinct paths with colliding hashes are stored under successive keys, so every hit must compare the path itself.
+	for (Hash key = hash;; ++key) {
+		const auto* entry = shard.Find(key);
+		if (!entry) { entry = shard.EmplaceYield(key, normalized, hash); }
+		if (entry->Path == normalized) { return entry; }
+	}
+}
+
+InternedPath::InternedPath() {
+	static const InternedPathEntry* emptyEntry = Intern({});
+	_entry                                     = emptyEntry;
+}
+
+InternedPath::InternedPath(const char* pathStr) : _entry(Intern(pathStr)) {}
+
+InternedPath::InternedPath(const std::string& pathStr) : _entry(Intern(pathStr)) {}
+
+InternedPath::InternedPath(std::string_view pathStr) : _entry(Intern(pathStr)) {}
+
+InternedPath::InternedPath(const Path& path) : _entry(Intern(path.String())) {}
+
+bool InternedPath::Empty() const noexcept {
+	return _entry->Path.empty();
+}
+
+Hash InternedPath::GetHash() const noexcept {
+	return _entry->PathHash;
+}
+
+const std::string& InternedPath::String() const noexcept {
+	return _entry->Path;
+}
+
+Path InternedPath::ToPath() const {
+	return Path(_entry->Path);
+}
+
+std::string_view InternedPath::Extension() const noexcept {
+	return std::string_view(_entry->Path).substr(_entry->ExtensionOffset);
+}
+
+std::string_view InternedPath::Filename() const noexcept {
+	return std::string_view(_entry->Path).substr(_entry->FilenameOffset);
+}
+
+std::string_view InternedPath::FilePath() const noexcept {
+	return std::string_view(_entry->Path).substr(_entry->FilePathOffset);
+}
+
+std::string_view InternedPath::ParentPath() const noexcept {
+	const std::string_view path(_entry->Path);
+	if (Filename().empty()) { return {}; }
+
+	// No directory separator after the protocol, so the parent is the protocol root itself (or nothing).
+	if (_entry->FilenameOffset == _entry->FilePathOffset) { return path.substr(0, _entry->FilePathOffset); }
+
+	// Keep the slash when the parent is the root directory.
+	if (_entry->FilenameOffset - 1 == _entry->FilePathOffset) { return path.substr(0, _entry->FilenameOffset); }
+
+	return path.substr(0, _entry->FilenameOffset - 1);
+}
+
+std::string_view InternedPath::Protocol() const noexcept {
+	if (_entry->FilePathOffset == 0) { return {}; }
+
+	return std::string_view(_entry->Path).substr(0, _entry->FilePathOffset - 3);
+}
+
+std::string_view InternedPath::Stem() const noexcept {
+	return std::string_view(_entry->Path)
+	  .substr(_entry->FilenameOffset, _entry->ExtensionOffset - _entry->FilenameOffset);
+}
+}  // namespace Luna
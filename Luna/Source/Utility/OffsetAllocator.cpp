@@ -0,0 +1,210 @@
+#include <Luna/Utility/BitOps.hpp>
+#include <Luna/Utility/OffsetAllocator.hpp>
+
+namespace Luna {
+// Sizes are mapped to bins through an 8-bit float with a 3-bit mantissa, so each power of two is split into 8 bins.
+constexpr static uint32_t MantissaBits  = 3;
+constexpr static uint32_t MantissaValue = 1 << MantissaBits;
+constexpr static uint32_t MantissaMask  = MantissaValue - 1;
+
+/** The smallest bin whose every range fits the given size. */
+static uint32_t SizeToBinRoundUp(uint32_t size) {
+	if (size < MantissaValue) { return size; }
+
+	const uint32_t highestSetBit    = 31 - LeadingZeroes(size);
+	const uint32_t mantissaStartBit = highestSetBit - MantissaBits;
+	const uint32_t exponent         = mantissaStartBit + 1;
+	uint32_t mantissa               = (size >> mantissaStartBit) & MantissaMask;
+	if ((size & ((1u << mantissaStartBit) - 1)) != 0) { ++mantissa; }
+
+	// A mantissa which rounds up to MantissaValue carries into the exponent, which is the correct next bin.
+	return (exponent << MantissaBits) + mantissa;
+}
+
+/** The bin which a free range of the given size is stored in. */
+static uint32_t SizeToBinRoundDown(uint32_t size) {
+	if (size < MantissaValue) { return size; }
+
+	const uint32_t highestSetBit    = 31 - LeadingZeroes(size);
+	const uint32_t mantissaStartBit = highestSetBit - MantissaBits;
+	const uint32_t exponent         = mantissaStartBit + 1;
+	const uint32_t mantissa         = (size >> mantissaStartBit) & MantissaMask;
+
+	return (exponent << MantissaBits) | mantissa;
+}
+
+/** The smallest size stored in the given bin. */
+static uint32_t BinToSize(uint32_t bin) {
+	const uint32_t exponent = bin >> MantissaBits;
+	const uint32_t mantissa = bin & MantissaMask;
+	if (exponent == 0) { return mantissa; }
+
+	return (mantissa | MantissaValue) << (exponent - 1);
+}
+
+/** The index of the lowest set bit at or above startBit, or 32 if there is none. */
+static uint32_t FindLowestSetBitAfter(uint32_t mask, uint32_t startBit) {
+	if (startBit >= 32) { return 32; }
+
+	return TrailingZeroes(mask & ~((1u << startBit) - 1));
+}
+
+OffsetAllocator::OffsetAllocator(uint32_t size, uint32_t maxNodes) : _size(size), _maxNodes(maxNodes) {
+	Reset();
+}
+
+OffsetAllocator::Allocation OffsetAllocator::Allocate(uint32_t size) {
+	// An allocation may split its range in two, which needs a spare node.
+	if (size == 0 || _freeNodes.empty()) { return {}; }
+
+	const uint32_t minBin     = SizeToBinRoundUp(size);
+	const uint32_t minTopBin  = minBin / BinsPerLeaf;
+	const uint32_t minLeafBin = minBin % BinsPerLeaf;
+
+	uint32_t topBin  = minTopBin;
+	uint32_t leafBin = 32;
+	if (_usedBinsTop & (1u << topBin)) { leafBin = FindLowestSetBitAfter(_usedBins[topBin], minLeafBin); }
+	if (leafBin == 32) {
+		topBin = FindLowestSetBitAfter(_usedBinsTop, minTopBin + 1);
+		if (topBin == 32) { return {}; }
+		leafBin = TrailingZeroes(_usedBins[topBin]);
+	}
+
+	const uint32_t bin       = topBin * BinsPerLeaf + leafBin;
+	const uint32_t nodeIndex = _binIndices[bin];
+	auto& node               = _nodes[nodeIndex];
+	const uint32_t totalSize = node.DataSize;
+	node.DataSize            = size;
+	node.Used                = true;
+
+	// Take the node from the head of its bin.
+	_binIndices[bin] = node.BinListNext;
+	if (node.BinListNext != Unused) { _nodes[node.BinListNext].BinListPrev = Unused; }
+	node.BinListNext = Unused;
+	_freeStorage -= totalSize;
+	if (_binIndices[bin] == Unused) {
+		_usedBins[topBin] &= ~(1u << leafBin);
+		if (_usedBins[topBin] == 0) { _usedBinsTop &= ~(1u << topBin); }
+	}
+
+	// Return whatever is left over to the free bins, as a new neighbor directly after the allocation.
+	const uint32_t remainder = totalSize - size;
+	if (remainder > 0) {
+		const uint32_t newNodeIndex = InsertNodeIntoBin(remainder, node.DataOffset + size);
+		if (node.NeighborNext != Unused) { _nodes[node.NeighborNext].NeighborPrev = newNodeIndex; }
+		_nodes[newNodeIndex].NeighborPrev = nodeIndex;
+		_nodes[newNodeIndex].NeighborNext = node.NeighborNext;
+		node.NeighborNext                 = newNodeIndex;
+	}
+
+	return {node.DataOffset, nodeIndex};
+}
+
+void OffsetAllocator::Free(Allocation allocation) {
+	if (!allocation) { return; }
+
+	auto& node        = _nodes[allocation.Node];
+	uint32_t offset   = node.DataOffset;
+	uint32_t size     = node.DataSize;
+	uint32_t prevNode = node.NeighborPrev;
+	uint32_t nextNode = node.NeighborNext;
+
+	// Merge with free neighbors on either side, so the range is binned at its full size.
+	if (prevNode != Unused && !_nodes[prevNode].Used) {
+		offset = _nodes[prevNode].DataOffset;
+		size += _nodes[prevNode].DataSize;
+		RemoveNodeFromBin(prevNode);
+		prevNode = _nodes[prevNode].NeighborPrev;
+	}
+	if (nextNode != Unused && !_nodes[nextNode].Used) {
+		size += _nodes[nextNode].DataSize;
+		RemoveNodeFromBin(nextNode);
+		nextNode = _nodes[nextNode].NeighborNext;
+	}
+
+	node = {};
+	_freeNodes.push_back(allocation.Node);
+
+	const uint32_t mergedNode = InsertNodeIntoBin(size, offset);
+	if (nextNode != Unused) {
+		_nodes[mergedNode].NeighborNext = nextNode;
+		_nodes[nextNode].NeighborPrev   = mergedNode;
+	}
+	if (prevNode != Unused) {
+		_nodes[mergedNode].NeighborPrev = prevNode;
+		_nodes[prevNode].NeighborNext   = mergedNode;
+	}
+}
+
+void OffsetAllocator::Reset() {
+	_freeStorage = 0;
+	_usedBinsTop = 0;
+	_usedBins.fill(0);
+	_binIndices.fill(Unused);
+
+	_nodes.assign(_maxNodes, Node{});
+	_freeNodes.resize(_maxNodes);
+	// Nodes are taken from the back, so the lowest indices are used first.
+	for (uint32_t i = 0; i < _maxNodes; ++i) { _freeNodes[i] = _maxNodes - i - 1; }
+
+	if (_size > 0) { InsertNodeIntoBin(_size, 0); }
+}
+
+uint32_t OffsetAllocator::GetAllocationSize(Allocation allocation) const {
+	return allocation ? _nodes[allocation.Node].DataSize : 0;
+}
+
+OffsetAllocator::StorageReport OffsetAllocator::GetStorageReport() const {
+	uint32_t largestFree = 0;
+	if (_usedBinsTop) {
+		const uint32_t topBin  = 31 - LeadingZeroes(_usedBinsTop);
+		const uint32_t leafBin = 31 - LeadingZeroes(uint32_t(_usedBins[topBin]));
+		largestFree            = BinToSize(topBin * BinsPerLeaf + leafBin);
+	}
+
+	return {_freeStorage, largestFree};
+}
+
+uint32_t OffsetAllocator::InsertNodeIntoBin(uint32_t size, uint32_t dataOffset) {
+	const uint32_t bin     = SizeToBinRoundDown(size);
+	const uint32_t topBin  = bin / BinsPerLeaf;
+	const uint32_t leafBin = bin % BinsPerLeaf;
+	if (_binIndices[bin] == Unused) {
+		_usedBins[topBin] |= 1u << leafBin;
+		_usedBinsTop |= 1u << topBin;
+	}
+
+	const uint32_t headIndex = _binIndices[bin];
+	const uint32_t nodeIndex = _freeNodes.back();
+	_freeNodes.pop_back();
+
+	_nodes[nodeIndex] = {.DataOffset = dataOffset, .DataSize = size, .BinListNext = headIndex};
+	if (headIndex != Unused) { _nodes[headIndex].BinListPrev = nodeIndex; }
+	_binIndices[bin] = nodeIndex;
+	_freeStorage += size;
+
+	return nodeIndex;
+}
+
+void OffsetAllocator::RemoveNodeFromBin(uint32_t nodeIndex) {
+	const auto& node = _nodes[nodeIndex];
+	if (node.BinListPrev != Unused) {
+		_nodes[node.BinListPrev].BinListNext = node.BinListNext;
+		if (node.BinListNext != Unused) { _nodes[node.BinListNext].BinListPrev = node.BinListPrev; }
+	} else {
+		// The node is the head of its bin.
+		const uint32_t bin     = SizeToBinRoundDown(node.DataSize);
+		const uint32_t topBin  = bin / BinsPerLeaf;
+		const uint32_t leafBin = bin % BinsPerLeaf;
+		_binIndices[bin]       = node.BinListNext;
+		if (node.BinListNext != Unused) { _nodes[node.BinListNext].BinListPrev = Unused; }
+		if (_binIndices[bin] == Unused) {
+			_usedBins[topBin] &= ~(1u << leafBin);
+			if (_usedBins[topBin] == 0) { _usedBinsTop &= ~(1u << topBin); }
+		}
+	}
+
+	_freeNodes.push_back(nodeIndex);
+	_freeStorage -= node.DataSize;
+}
+}  // namespace Luna
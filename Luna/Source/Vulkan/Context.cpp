@@ -391,6 +391,8 @@ void Context::CreateDevice(const std::vector<const char*>& requiredExtensions) {
 
 	TryFeature(Core.multiDrawIndirect, "Multi Draw Indirect");
 	TryFeature(Core.samplerAnisotropy, "Sampler Anisotropy");
+	TryFeature(Core.textureCompressionASTC_LDR, "ASTC Texture Compression");
+	TryFeature(Core.textureCompressionBC, "BC Texture Compression");
 	TryFeature(Vulkan12.bufferDeviceAddress, "Buffer Device Address");
 	TryFeature(Vulkan12.descriptorBindingPartiallyBound, "Descriptor Binding Partially Bound");
 	TryFeature(Vulkan12.descriptorBindingSampledImageUpdateAfterBind,
@@ -344,6 +344,24 @@ SamplerHandle Device::CreateSampler(const SamplerCreateInfo& samplerCI, const st
 	}
 }
 
+MemoryBudget Device::GetMemoryBudget() {
+	std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> heapBudgets;
+	{
+		DeviceMemoryLock();
+		vmaGetHeapBudgets(_allocator, heapBudgets.data());
+	}
+
+	MemoryBudget budget;
+	const auto& memory = _deviceInfo.Memory;
+	for (uint32_t i = 0; i < memory.memoryHeapCount; ++i) {
+		if (!(memory.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal)) { continue; }
+		budget.Usage += heapBudgets[i].usage;
+		budget.Budget += heapBudgets[i].budget;
+	}
+
+	return budget;
+}
+
 const Sampler& Device::GetStockSampler(StockSampler type) const {
 	return _stockSamplers[int(type)]->GetSampler();
 }
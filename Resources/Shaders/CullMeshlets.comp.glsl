@@ -7,6 +7,7 @@
 
 struct GetMeshletUvBoundsParams {
   uint MeshletID;
+  uint InstanceID;
   mat4 ViewProj;
   bool ClampNDC;
   bool ReverseZ;
@@ -30,7 +31,7 @@ layout(set = 1, binding = 2, scalar) restrict readonly buffer TransformBuffer {
 layout(set = 1, binding = 3) uniform sampler2D HZB;
 
 layout(set = 1, binding = 4, scalar) restrict writeonly buffer VisibleMeshletsBuffer {
-  uint VisibleMeshlets[];
+  uvec2 VisibleMeshlets[];
 };
 layout(set = 1, binding = 5, scalar) restrict buffer CullTriangleDispatchBuffer {
   DispatchIndirectCommand CullTriangleDispatches[];
@@ -38,11 +39,30 @@ layout(set = 1, binding = 5, scalar) restrict buffer CullTriangleDispatchBuffer
 layout(set = 1, binding = 6, scalar) restrict buffer VisBufferStatsBuffer {
   VisBufferStats Stats;
 };
+layout(set = 1, binding = 7, scalar) restrict readonly buffer InstanceBuffer {
+  MeshInstance Instances[];
+};
+
+// Returns the instance a work item belongs to: the last one starting at or before it. Unused instances have no
+// meshlets and share their successor's first work item, so they are never the last.
+uint FindInstance(uint workItem) {
+  uint low = 0;
+  uint high = Uniforms.InstanceCount;
+  while (high - low > 1) {
+    uint middle = (low + high) / 2;
+    if (Instances[middle].FirstWorkItem <= workItem) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+
+  return low;
+}
 
 void GetMeshletUvBounds(GetMeshletUvBoundsParams params, out vec2 minXY, out vec2 maxXY, out float nearestZ, out bool intersectsNearPlane) {
   uint meshletId = params.MeshletID;
-  uint instanceId = Meshlets[meshletId].InstanceID;
-  mat4 transform = Transforms[instanceId];
+  mat4 transform = Transforms[params.InstanceID];
   vec3 aabbMin = Meshlets[meshletId].AABBMin;
   vec3 aabbMax = Meshlets[meshletId].AABBMax;
   vec4 aabbSize = vec4(aabbMax - aabbMin, 0.0);
@@ -90,10 +110,9 @@ bool IsAABBInsidePlane(vec3 center, vec3 extent, vec4 plane) {
   return (dot(normal, center) - plane.w) >= -radius;
 }
 
-bool CullMeshletFrustum(uint meshletId) {
+bool CullMeshletFrustum(uint meshletId, uint instanceId) {
   if ((Uniforms.Flags & CullMeshletFrustumBit) == 0) { return true; }
 
-  uint instanceId = Meshlets[meshletId].InstanceID;
   mat4 transform = Transforms[instanceId];
   vec3 aabbMin = Meshlets[meshletId].AABBMin;
   vec3 aabbMax = Meshlets[meshletId].AABBMax;
@@ -122,6 +141,42 @@ bool CullMeshletFrustum(uint meshletId) {
   return true;
 }
 
+// Returns false if every triangle in the meshlet faces away from the camera.
+bool CullMeshletBackface(uint meshletId, uint instanceId) {
+  if ((Uniforms.Flags & CullMeshletBackfaceBit) == 0) { return true; }
+
+  mat4 transform = Transforms[instanceId];
+  vec4 cone = unpackSnorm4x8(Meshlets[meshletId].ConeAxisCutoff);
+  vec3 coneApex = vec3(transform * vec4(Meshlets[meshletId].ConeApex, 1.0));
+  // The cutoff is preserved by rotation and uniform scale, which covers the transforms used by the scene.
+  vec3 coneAxis = normalize(mat3(transform) * cone.xyz);
+
+  return dot(normalize(coneApex - Scene.CameraPosition.xyz), coneAxis) < cone.w;
+}
+
+// Projects a mesh-space LOD error, measured from the given bounding sphere, to a size in pixels.
+float ProjectLodError(mat4 transform, vec4 bounds, float error) {
+  vec3 center = vec3(transform * vec4(bounds.xyz, 1.0));
+  float scale = max(max(length(transform[0].xyz), length(transform[1].xyz)), length(transform[2].xyz));
+  float sphereDistance = max(length(center - Scene.CameraPosition.xyz) - bounds.w * scale, 1e-4);
+
+  return (error * scale / sphereDistance) * Scene.Projection[1][1] * Scene.ViewportExtent.y * 0.5;
+}
+
+// Returns false if the meshlet is not part of this view's cut through its mesh's cluster DAG. A cluster is drawn when
+// its own error is below the threshold but its parent's is not. Projected errors never shrink from a cluster to its
+// parent, so every cluster makes this choice independently and the cut is still free of cracks and overlaps.
+bool CullMeshletLod(uint meshletId, uint instanceId) {
+  if ((Uniforms.Flags & CullMeshletLodBit) == 0) { return Meshlets[meshletId].LodError == 0.0; }
+
+  mat4 transform = Transforms[instanceId];
+  Meshlet meshlet = Meshlets[meshletId];
+  float error = ProjectLodError(transform, meshlet.LodBounds, meshlet.LodError);
+  float parentError = ProjectLodError(transform, meshlet.ParentLodBounds, meshlet.ParentLodError);
+
+  return error <= Uniforms.LodErrorThreshold && parentError > Uniforms.LodErrorThreshold;
+}
+
 bool CullQuadHiZ(vec2 minXY, vec2 maxXY, float nearestZ) {
   vec4 boxUvs = vec4(minXY, maxXY);
   boxUvs.y = 1.0 - boxUvs.y;
@@ -142,16 +197,21 @@ void main() {
   uint meshletsPerBatch = gl_NumWorkGroups.x;
   uint batchId = gl_GlobalInvocationID.y;
   uint meshletOffset = batchId * meshletsPerBatch;
-  uint meshletId = gl_WorkGroupID.x + meshletOffset;
-  if (meshletId >= Uniforms.MeshletCount) { return; }
+  uint workItem = gl_WorkGroupID.x + meshletOffset;
+  if (workItem >= Uniforms.MeshletCount) { return; }
+
+  uint instanceId = FindInstance(workItem);
+  uint meshletId = Instances[instanceId].MeshletOffset + (workItem - Instances[instanceId].FirstWorkItem);
 
   bool isVisible = false;
-  if (CullMeshletFrustum(meshletId)) {
+  if (CullMeshletLod(meshletId, instanceId) && CullMeshletBackface(meshletId, instanceId) &&
+      CullMeshletFrustum(meshletId, instanceId)) {
     isVisible = true;
 
     if ((Uniforms.Flags & CullMeshletHiZBit) != 0) {
       GetMeshletUvBoundsParams params;
       params.MeshletID = meshletId;
+      params.InstanceID = instanceId;
       params.ViewProj = Scene.ViewProjection;
       params.ClampNDC = true;
       params.ReverseZ = true;
@@ -170,7 +230,7 @@ void main() {
 
   if (isVisible) {
     uint index = atomicAdd(CullTriangleDispatches[batchId].x, 1);
-    VisibleMeshlets[index + meshletOffset] = meshletId;
+    VisibleMeshlets[index + meshletOffset] = uvec2(meshletId, instanceId);
     atomicAdd(Stats.VisibleMeshlets, 1);
   }
 }
@@ -25,7 +25,11 @@ layout(set = 1, binding = 2, scalar) restrict readonly buffer ScenePositions {
   vec3 Positions[];
 };
 layout(set = 1, binding = 3, scalar) restrict readonly buffer SceneAttributes {
+#ifdef QUANTIZED_VERTICES
+  QuantizedVertex Attributes[];
+#else
   Vertex Attributes[];
+#endif
 };
 layout(set = 1, binding = 4, scalar) restrict readonly buffer SceneIndices {
   uint Indices[];
@@ -38,7 +42,7 @@ layout(set = 1, binding = 6, scalar) restrict readonly buffer TransformBuffer {
 };
 layout(set = 1, binding = 7) uniform sampler2D HZB;
 layout(set = 1, binding = 8, scalar) restrict readonly buffer VisibleMeshletsBuffer {
-  uint VisibleMeshlets[];
+  uvec2 VisibleMeshlets[];
 };
 
 layout(set = 1, binding = 9, scalar) restrict writeonly buffer DrawIndirect {
@@ -102,9 +106,9 @@ bool CullTriangle(uint meshletId, uint localId) {
   vec3 position1 = Positions[vertexOffset + index1];
   vec3 position2 = Positions[vertexOffset + index2];
 
-  Vertex vertex0 = Attributes[vertexOffset + index0];
-  Vertex vertex1 = Attributes[vertexOffset + index1];
-  Vertex vertex2 = Attributes[vertexOffset + index2];
+  Vertex vertex0 = DecodeVertex(Attributes[vertexOffset + index0]);
+  Vertex vertex1 = DecodeVertex(Attributes[vertexOffset + index1]);
+  Vertex vertex2 = DecodeVertex(Attributes[vertexOffset + index2]);
 
   vec4 posClip0 = sMVP * vec4(position0, 1.0);
   vec4 posClip1 = sMVP * vec4(position1, 1.0);
@@ -142,12 +146,13 @@ void main() {
   uint meshletsPerBatch = gl_NumWorkGroups.x;
   uint batchId = BatchID;
   uint meshletOffset = batchId * Uniforms.MeshletsPerBatch;
-  uint meshletId = VisibleMeshlets[gl_WorkGroupID.x + meshletOffset];
-  if (meshletId >= Uniforms.MeshletCount) { return; }
+  // The visbuffer identifies triangles by their meshlet's slot in VisibleMeshlets, which also holds its instance.
+  uint visibleId = gl_WorkGroupID.x + meshletOffset;
+  uint meshletId = VisibleMeshlets[visibleId].x;
+  uint instanceId = VisibleMeshlets[visibleId].y;
 
   uint localId = gl_LocalInvocationID.x;
   if (localId == 0) {
-    uint instanceId = Meshlets[meshletId].InstanceID;
     sPrimitivesPassed = 0;
     sMVP = Scene.ViewProjection * Transforms[instanceId];
   }
@@ -176,8 +181,8 @@ void main() {
   if (primitivePassed) {
     uint triangleId = localId * 3;
     uint indexOffset = sBaseIndex + (batchId * Uniforms.IndicesPerBatch) + activePrimitiveId * 3;
-    MeshletIndices[indexOffset + 0] = (meshletId << MeshletPrimitiveBits) | ((triangleId + 0) & MeshletPrimitiveMask);
-    MeshletIndices[indexOffset + 1] = (meshletId << MeshletPrimitiveBits) | ((triangleId + 1) & MeshletPrimitiveMask);
-    MeshletIndices[indexOffset + 2] = (meshletId << MeshletPrimitiveBits) | ((triangleId + 2) & MeshletPrimitiveMask);
+    MeshletIndices[indexOffset + 0] = (visibleId << MeshletPrimitiveBits) | ((triangleId + 0) & MeshletPrimitiveMask);
+    MeshletIndices[indexOffset + 1] = (visibleId << MeshletPrimitiveBits) | ((triangleId + 1) & MeshletPrimitiveMask);
+    MeshletIndices[indexOffset + 2] = (visibleId << MeshletPrimitiveBits) | ((triangleId + 2) & MeshletPrimitiveMask);
   }
 }
@@ -15,7 +15,11 @@ layout(set = 1, binding = 2, scalar) readonly buffer VertexPositions {
   vec3 Positions[];
 };
 layout(set = 1, binding = 3, scalar) readonly buffer VertexAttributes {
+#ifdef QUANTIZED_VERTICES
+  QuantizedVertex Attributes[];
+#else
   Vertex Attributes[];
+#endif
 };
 layout(set = 1, binding = 4, scalar) readonly buffer MeshletIndices {
   uint Indices[];
@@ -26,23 +30,27 @@ layout(set = 1, binding = 5, scalar) readonly buffer MeshletPrimitives {
 layout(set = 1, binding = 6, scalar) readonly buffer TransformBuffer {
   mat4 Transforms[];
 };
+layout(set = 1, binding = 7, scalar) readonly buffer VisibleMeshletsBuffer {
+  uvec2 VisibleMeshlets[];
+};
 
 layout(location = 0) flat out uint outMeshlet;
 layout(location = 1) out vec3 outNormal;
 
 void main() {
-  const uint meshletId = (uint(gl_VertexIndex) >> MeshletPrimitiveBits) & MeshletIdMask;
+  const uint visibleId = (uint(gl_VertexIndex) >> MeshletPrimitiveBits) & MeshletIdMask;
   const uint primitiveId = uint(gl_VertexIndex) & MeshletPrimitiveMask;
+  const uint meshletId = VisibleMeshlets[visibleId].x;
+  const uint instanceId = VisibleMeshlets[visibleId].y;
 
   const uint vertexOffset   = Meshlets[meshletId].VertexOffset;
   const uint indexOffset    = Meshlets[meshletId].IndexOffset;
   const uint triangleOffset = Meshlets[meshletId].TriangleOffset;
-  const uint instanceId     = Meshlets[meshletId].InstanceID;
 
   const uint primitive = uint(Triangles[triangleOffset + primitiveId]);
   const uint index = Indices[indexOffset + primitive];
   const vec3 position = Positions[vertexOffset + index];
-  const Vertex vertex = Attributes[vertexOffset + index];
+  const Vertex vertex = DecodeVertex(Attributes[vertexOffset + index]);
   const mat4 transform = Transforms[instanceId];
 
   outMeshlet = meshletId;